@@ -0,0 +1,72 @@
+/**
+ * @file replay.cxx
+ * @brief Runs a fuzz harness over a corpus, for builds without libFuzzer.
+ *
+ * Every file of the given directories is passed to the harness as is, then repeated up to
+ * `REPLAY_SCALED_SIZE` bytes, once as it is and once joined into a single line, so that the
+ * time-per-byte oracle of the harness sees long inputs and long lines even when no fuzzer
+ * generates them. The program fails (through the harness) on the first crash or slow input.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace
+{
+    /**
+     * @brief The size to which every input of the corpus is repeated.
+     */
+    constexpr size_t REPLAY_SCALED_SIZE = 1024 * 1024; // 1 MB
+
+    /**
+     * @brief Passes an input to the harness.
+     *
+     * @param input The input.
+     */
+    void run_input(const std::string &input)
+    {
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::filesystem::path> paths;
+    for (int argidx = 1; argidx < argc; argidx++)
+    {
+        if (!std::filesystem::is_directory(argv[argidx]))
+        {
+            paths.emplace_back(argv[argidx]);
+            continue;
+        }
+        for (const auto &entry : std::filesystem::directory_iterator(argv[argidx]))
+            paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto &path : paths)
+    {
+        std::ifstream file(path, std::ios::binary);
+        const std::string input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        run_input(input);
+        if (input.empty())
+            continue;
+        std::string scaled;
+        scaled.reserve(REPLAY_SCALED_SIZE + input.size());
+        while (scaled.size() < REPLAY_SCALED_SIZE)
+            scaled += input;
+        run_input(scaled);
+        std::replace(scaled.begin(), scaled.end(), '\n', ' ');
+        run_input(scaled);
+    }
+    std::cout << "Replayed " << paths.size() << " input(s)\n";
+    return paths.empty() ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file tokenize_fuzzer.cxx
+ * @brief Fuzzes the lexer of the Zylo programming language.
+ *
+ * This file contains a libFuzzer harness for `tokenize`. Besides the crashes and sanitizer reports
+ * found by the fuzzer, the harness checks that tokenizing takes linear time: an input taking
+ * longer than `FUZZ_NANOSECONDS_PER_BYTE` per byte, plus `FUZZ_TIME_ALLOWANCE`, is reported as
+ * slow and aborts the run, so that libFuzzer keeps it as a crash input. Quadratic behavior only
+ * stands out on long inputs, so the fuzzer should be run with a large `-max_len`, such as
+ * `-max_len=1048576`.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include "internal/lexer.hxx"
+
+namespace
+{
+    /**
+     * @brief The time tokenizing may take for each byte of input.
+     *
+     * The bound is far above the actual cost, even in sanitized builds, so that only inputs
+     * growing faster than linearly can exceed it.
+     */
+    constexpr std::chrono::nanoseconds FUZZ_NANOSECONDS_PER_BYTE(5000);
+
+    /**
+     * @brief The time any input may take, which keeps short inputs clear of timer noise.
+     */
+    constexpr std::chrono::milliseconds FUZZ_TIME_ALLOWANCE(50);
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const std::string_view source(reinterpret_cast<const char *>(data), size);
+    const auto start = std::chrono::steady_clock::now();
+    zylo::Diagnostics diagnostics;
+    tokenize(source, diagnostics, diagnostics.add_file("<fuzz>"));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    if (elapsed > FUZZ_NANOSECONDS_PER_BYTE * static_cast<long long>(size) + FUZZ_TIME_ALLOWANCE)
+    {
+        std::fprintf(stderr, "Slow input: %zu bytes tokenized in %lld ms\n", size,
+                     static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+        std::abort();
+    }
+    return 0;
+}
@@ -3,4 +3,4 @@ REM Ensure the build directory exists
 if not exist build mkdir build
 
 REM Compile the project
-g++ -o ./build/zylo ./src/main.cxx ./src/terminal.cxx -I./src -I./src/utilities -std=c++17
+g++ -o ./build/zylo ./src/main.cxx ./src/terminal.cxx ./src/runner.cxx ./src/internal/lexer.cxx ./src/internal/cache.cxx ./src/internal/formatter.cxx ./src/internal/module.cxx ./src/internal/macro.cxx ./src/internal/template.cxx ./src/utilities/error.cxx ./src/utilities/diagnostics.cxx ./src/utilities/io.cxx ./src/utilities/json.cxx -I./src -I./src/utilities -std=c++17
@@ -0,0 +1,93 @@
+/**
+ * @file cache.cxx
+ * @brief Implementation of the source cache for the Zylo programming language.
+ *
+ * This file contains the implementation of the `SourceCache` class declared in `cache.hxx`.
+ * Files are tokenized outside of the cache lock, so several threads can load different files
+ * at the same time.
+ */
+
+#include <fstream>
+#include <iterator>
+#include "cache.hxx"
+#include "io.hxx"
+
+uint64_t zylo::hash_source(std::string_view source)
+{
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+    for (const unsigned char chr : source)
+    {
+        hash ^= chr;
+        hash *= 1099511628211ULL; // FNV-1a prime
+    }
+    return hash;
+}
+
+zylo::SourceCache::Tokens zylo::SourceCache::load(const std::string &path)
+{
+    std::error_code errcode;
+    const auto status = std::filesystem::status(path, errcode);
+    if (errcode)
+        return nullptr;
+    if (status.type() != std::filesystem::file_type::regular)
+    {
+        // Pipes and devices (`<(gen)`, `/dev/stdin`) cannot be mapped and can only be read once
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file)
+            return nullptr;
+        const std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return std::make_shared<const std::vector<Token>>(tokenize(source));
+    }
+    const auto mtime = std::filesystem::last_write_time(path, errcode);
+    if (errcode)
+        return nullptr;
+    const std::uintmax_t size = std::filesystem::file_size(path, errcode);
+    if (errcode)
+        return nullptr;
+    {
+        // The size catches most of the edits made within the resolution of the file system clock
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto entry = entries.find(path);
+        if (entry != entries.end() && entry->second.mtime == mtime && entry->second.size == size)
+            return entry->second.tokens;
+    }
+
+    const MappedFile file(path);
+    if (!file.is_open())
+        return nullptr;
+    const uint64_t hash = hash_source(file.view());
+    {
+        // The file was only touched, keep the cached tokens and remember the new time
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto entry = entries.find(path);
+        if (entry != entries.end() && entry->second.hash == hash)
+        {
+            entry->second.mtime = mtime;
+            entry->second.size = size;
+            return entry->second.tokens;
+        }
+    }
+
+    Tokens tokens = std::make_shared<const std::vector<Token>>(tokenize(file.view()));
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[path] = {mtime, size, hash, tokens};
+    return tokens;
+}
+
+void zylo::SourceCache::invalidate(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.erase(path);
+}
+
+void zylo::SourceCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+size_t zylo::SourceCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
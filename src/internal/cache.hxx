@@ -0,0 +1,121 @@
+/**
+ * @file cache.hxx
+ * @brief Defines the source cache for the Zylo programming language.
+ *
+ * This file contains the declaration of the `SourceCache` class, which keeps the processed form
+ * of Zylo source files in memory so that a long-lived process does not have to read and process
+ * the same file again. Cached entries are invalidated when the modification time or the size of
+ * the file changes and its contents hash to a different value, so touching a file without editing
+ * it keeps the cached result.
+ */
+
+#ifndef ZYLO_INTERNAL_CACHE_HXX // ZYLO_INTERNAL_CACHE_HXX
+
+#define ZYLO_INTERNAL_CACHE_HXX
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "lexer.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @brief Computes the hash of a piece of source code.
+     *
+     * This function computes a 64-bit FNV-1a hash of the given source code. It is used to detect
+     * whether the contents of a file really changed when its modification time did.
+     *
+     * @param source The source code to hash.
+     * @return The 64-bit hash of the source code.
+     */
+    uint64_t hash_source(std::string_view source);
+
+    /**
+     * @class SourceCache
+     * @brief A thread-safe cache of processed Zylo source files.
+     *
+     * The `SourceCache` class maps file paths to the token streams produced for them. Entries are
+     * shared and immutable, so callers may keep using a token stream after its entry has been
+     * replaced. All methods may be called concurrently from several threads.
+     */
+    class SourceCache
+    {
+    public:
+        /**
+         * @brief Type of the token streams stored in the cache.
+         *
+         * Token streams are shared between the cache and its callers and never modified once stored.
+         */
+        using Tokens = std::shared_ptr<const std::vector<Token>>;
+
+        /**
+         * @brief Loads the token stream of a file, using the cached one when it is still valid.
+         *
+         * This method returns the cached token stream without reading the file when neither its
+         * modification time nor its size has changed. Otherwise the file is mapped into memory and
+         * hashed, and it is only tokenized again when the hash differs from the cached one. A path
+         * that is not a regular file, such as a pipe, is read as a stream and never cached.
+         *
+         * @note An edit that keeps the size of the file and happens within the resolution of the
+         * file system clock is not seen; `invalidate` forces the file to be read again.
+         *
+         * @param path The path of the file to load.
+         * @return The token stream of the file, or `nullptr` if the file cannot be read.
+         */
+        Tokens load(const std::string &path);
+
+        /**
+         * @brief Removes the cached entry of a file, if any.
+         *
+         * @param path The path of the file whose entry is removed.
+         */
+        void invalidate(const std::string &path);
+
+        /**
+         * @brief Removes all cached entries.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the number of cached entries.
+         *
+         * @return The number of files currently cached.
+         */
+        size_t size() const;
+
+    private:
+        /**
+         * @struct Entry
+         * @brief Represents a cached file.
+         *
+         * This structure stores the state of the file when it was cached alongside its token stream.
+         */
+        struct Entry
+        {
+            std::filesystem::file_time_type mtime; // The modification time of the file when it was cached.
+            std::uintmax_t size;                   // The size of the file when it was cached.
+            uint64_t hash;                         // The hash of the contents of the file when it was cached.
+            Tokens tokens;                         // The token stream of the file.
+        };
+
+        /**
+         * @brief The cached entries, indexed by file path.
+         */
+        std::unordered_map<std::string, Entry> entries;
+
+        /**
+         * @brief Protects `entries` against concurrent access.
+         */
+        mutable std::mutex mutex;
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_INTERNAL_CACHE_HXX
@@ -0,0 +1,119 @@
+/**
+ * @file formatter.cxx
+ * @brief Implementation of the source formatter for the Zylo programming language.
+ *
+ * This file contains the implementation of the formatter declared in `formatter.hxx`. The
+ * layout of every token only depends on the token itself, the token written before it on the
+ * same line (and, for brackets, their position in the source) and the current bracket depth, so
+ * a single pass over the token stream is enough.
+ */
+
+#include <string>
+#include "formatter.hxx"
+
+void zylo::format_tokens(const std::vector<Token> &tokens, std::ostream &ostream, std::string_view newline)
+{
+    auto isopening = [](const Token &token) -> bool
+    {
+        return token.type == TokenType::OpenParen || token.type == TokenType::OpenBracket;
+    };
+    auto isclosing = [](const Token &token) -> bool
+    {
+        return token.type == TokenType::CloseParen || token.type == TokenType::CloseBracket;
+    };
+    // Operands that a postfix operator, a call or an index can follow
+    auto isoperand = [&isclosing](const Token &token) -> bool
+    {
+        return token.type == TokenType::Identifier || isclosing(token);
+    };
+    // Whether two tokens of the same line touch in the source, which only holds for tokens written as their value
+    auto istouching = [](const Token &previous, const Token &token) -> bool
+    {
+        return token.column != 0 && token.column == previous.column + previous.value.size();
+    };
+    // Whether two tokens written without a space between them are still lexed apart: `! !x` must not become `!!x`
+    auto isseparate = [](const Token &previous, const Token &token) -> bool
+    {
+        // The content of a string does not change where it starts or ends
+        const std::string prevvalue = previous.type == TokenType::String ? "\"\"" : previous.value;
+        const std::string joined = prevvalue + (token.type == TokenType::String ? "\"\"" : token.value);
+        std::string_view line = joined;
+        return extract_identifier(line) == prevvalue;
+    };
+
+    const Token *prevtk = nullptr; // The previous token on the current line, if any
+    bool attachnext = false;       // Whether the next token sticks to the previous one (prefix operators)
+    bool anyline = false;          // Whether a line with tokens has been written
+    int blanklines = 0;            // The number of blank lines found since the last written line
+    int depth = 0;                 // The number of brackets left open
+
+    for (const auto &token : tokens)
+    {
+        if (token.type == TokenType::EndOfFile)
+            break;
+        if (token.type == TokenType::EndOfLine && token.value == "\n")
+        {
+            if (prevtk == nullptr)
+                blanklines++;
+            else
+                ostream << newline;
+            prevtk = nullptr;
+            attachnext = false;
+            continue;
+        }
+
+        if (prevtk == nullptr)
+        {
+            if (blanklines > 0 && anyline)
+                ostream << newline;
+            blanklines = 0;
+            anyline = true;
+            // A line starting with a closing bracket lines up with the line that opened it
+            const int indent = isclosing(token) && depth > 0 ? depth - 1 : depth;
+            ostream << std::string(static_cast<size_t>(indent * FORMATTER_INDENT_WIDTH), ' ');
+        }
+        else
+        {
+            const bool attached = attachnext || isopening(*prevtk) || isclosing(token) ||
+                                  token.type == TokenType::EndOfLine || token.type == TokenType::Comma ||
+                                  (isopening(token) && isoperand(*prevtk) && istouching(*prevtk, token)) ||
+                                  (token.type == TokenType::UnaryOperator && token.value != "!" && isoperand(*prevtk));
+            if (!attached || !isseparate(*prevtk, token))
+                ostream << ' ';
+        }
+
+        attachnext = token.type == TokenType::UnaryOperator && (token.value == "!" || prevtk == nullptr || !isoperand(*prevtk));
+        switch (token.type)
+        {
+        case TokenType::String:
+        {
+            std::string value = token.value;
+            unprocess_escape_characters(value);
+            ostream << '\"' << value << '\"';
+            break;
+        }
+        case TokenType::OpenParen:
+        case TokenType::OpenBracket:
+            depth++;
+            ostream << token.value;
+            break;
+        case TokenType::CloseParen:
+        case TokenType::CloseBracket:
+            depth = depth > 0 ? depth - 1 : 0;
+            ostream << token.value;
+            break;
+        default:
+            ostream << token.value;
+            break;
+        }
+        prevtk = &token;
+    }
+    if (prevtk != nullptr)
+        ostream << newline;
+}
+
+std::string_view zylo::detect_line_ending(std::string_view source)
+{
+    const size_t lineend = source.find('\n');
+    return lineend != std::string_view::npos && lineend > 0 && source[lineend - 1] == '\r' ? "\r\n" : "\n";
+}
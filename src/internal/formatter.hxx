@@ -0,0 +1,61 @@
+/**
+ * @file formatter.hxx
+ * @brief Defines the source formatter for the Zylo programming language.
+ *
+ * This file contains the declaration of the formatter, which rewrites Zylo source code in a
+ * canonical layout. The formatter works directly on the token stream produced by the lexer,
+ * comments included, and writes its output as it walks the tokens, so it never needs to build
+ * a syntax tree of the program.
+ *
+ * The canonical layout separates tokens with a single space, attaches brackets, commas and unary
+ * operators to their operands, indents lines by the depth of the brackets left open, keeps at
+ * most one blank line in a row, and ends the file with a single line ending. The line endings of
+ * the source (LF or CRLF) are kept. Two tokens that would be lexed as one once written together,
+ * such as `!` and `!done`, always keep a space between them.
+ *
+ * Whether a bracket following an operand opens a call (or an index) or a block cannot be told
+ * without a grammar: `f(x)` and `if x ( ... )` are the same tokens. Such a bracket keeps the
+ * spacing it had in the source.
+ */
+
+#ifndef ZYLO_INTERNAL_FORMATTER_HXX // ZYLO_INTERNAL_FORMATTER_HXX
+
+#define ZYLO_INTERNAL_FORMATTER_HXX
+
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "lexer.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @brief The number of spaces used for each indentation level.
+     */
+    constexpr int FORMATTER_INDENT_WIDTH = 4;
+
+    /**
+     * @brief Writes a token stream to a stream in the canonical layout.
+     *
+     * This function walks the tokens once and writes each of them as soon as the spacing that
+     * precedes it is known. Tokens are expected to come from `tokenize`, so string tokens hold
+     * their processed value and line endings are present as `TokenType::EndOfLine` tokens.
+     *
+     * @param tokens The token stream to format.
+     * @param ostream The output stream where the formatted source code is written.
+     * @param newline The line ending to write, as returned by `detect_line_ending`.
+     */
+    void format_tokens(const std::vector<Token> &tokens, std::ostream &ostream, std::string_view newline = "\n");
+
+    /**
+     * @brief Detects the line ending used by a source, from its first line.
+     *
+     * @param source The source code.
+     * @return `"\r\n"` if the first line ends with CRLF, `"\n"` otherwise.
+     */
+    std::string_view detect_line_ending(std::string_view source);
+
+} // namespace zylo
+
+#endif // ZYLO_INTERNAL_FORMATTER_HXX
@@ -18,9 +18,11 @@
  * declarations for the lexer components.
  */
 
+#include <algorithm>
 #include <vector>
 #include "lexer.hxx"
-#include "error.hxx"
+#include "diagnostics.hxx"
+#include "io.hxx"
 
 TokenIdentifier TokenIdentifier::tk_identifiers[static_cast<int>(TokenType::Invalid)] = {
     {{}},                                                                            // Number
@@ -33,6 +35,8 @@ TokenIdentifier TokenIdentifier::tk_identifiers[static_cast<int>(TokenType::Inva
     {{"if"}},                                                                        // If
     {{"else"}},                                                                      // Else
     {{"while"}},                                                                     // While
+    {{"import"}},                                                                    // Import
+    {{"macro"}},                                                                     // Macro
     {{"="}},                                                                         // Equals
     {{"++", "--", "!"}},                                                             // UnaryOperator
     {{"+", "-", "*", "/", "%", "==", "!=", ">", "<", ">=", "<=", "**", "&&", "||"}}, // BinaryOperator
@@ -40,6 +44,7 @@ TokenIdentifier TokenIdentifier::tk_identifiers[static_cast<int>(TokenType::Inva
     {{")"}},                                                                         // CloseParen
     {{"["}},                                                                         // OpenBracket
     {{"]"}},                                                                         // CloseBracket
+    {{","}},                                                                         // Comma
     {{}},                                                                            // Identifier
     {{"#"}},                                                                         // Comment
     {{"\n", "\r", ";"}}                                                              // EndOfLine
@@ -47,62 +52,72 @@ TokenIdentifier TokenIdentifier::tk_identifiers[static_cast<int>(TokenType::Inva
 
 void process_escape_characters(std::string &string)
 {
-    for (int chridx = 0; chridx < string.size(); chridx++)
+    // Rewrite the string in place in a single pass, the result is never longer than the input
+    size_t outidx = 0;
+    for (size_t chridx = 0; chridx < string.size(); chridx++)
     {
-        const char chr = string[chridx];
-        if (chr == '\\' && chridx < string.size() - 1)
+        char chr = string[chridx];
+        if (chr == '\\' && chridx + 1 < string.size())
         {
-            const char nextchr = string[chridx + 1];
-            char replchr = ' '; // Default replacement character 8)
-            switch (nextchr)
+            switch (string[chridx + 1])
             {
             case 'n':
-                replchr = '\n';
+                chr = '\n';
+                chridx++;
                 break;
             case 't':
-                replchr = '\t';
+                chr = '\t';
+                chridx++;
+                break;
+            case '\"':
+            case '\\':
+                chr = string[++chridx];
                 break;
-            }
-            if (replchr != ' ')
-            {
-                // Replace the escape sequence with the actual character
-                string[chridx] = replchr;
-                // Remove the escape character
-                // NOTE: This is not efficient for large strings
-                string.erase(string.begin() + chridx + 1);
             }
         }
+        string[outidx++] = chr;
     }
+    string.resize(outidx);
 }
 
 void unprocess_escape_characters(std::string &string)
 {
-    for (int chridx = 0; chridx < string.size(); chridx++)
+    std::string escaped;
+    escaped.reserve(string.size());
+    for (size_t chridx = 0; chridx < string.size(); chridx++)
     {
         const char chr = string[chridx];
-        std::string inststr;
         switch (chr)
         {
         case '\n':
-            inststr = "\\n";
+            escaped += "\\n";
             break;
         case '\t':
-            inststr = "\\t";
+            escaped += "\\t";
             break;
-        }
-        if (!inststr.empty())
+        case '\"':
+            escaped += "\\\"";
+            break;
+        case '\\':
         {
-            string.erase(string.begin() + chridx);
-            string.insert(chridx, inststr);
-            chridx++;
+            // `process_escape_characters` keeps a backslash that does not start an escape sequence, so
+            // it is only escaped when the written character after it would make one (or at the end)
+            const char next = chridx + 1 < string.size() ? string[chridx + 1] : '\\';
+            const bool isescape = next == 'n' || next == 't' || next == '\n' || next == '\t' || next == '\"' || next == '\\';
+            escaped += isescape ? "\\\\" : "\\";
+            break;
+        }
+        default:
+            escaped += chr;
         }
     }
+    string.swap(escaped);
 }
 
-std::string extract_identifier(std::string &line, char separator)
+std::string extract_identifier(std::string_view &line, char separator)
 {
-    const char skpchrs[] = {' ', '\t', '\0'};
-    const char nonchainablechrs[] = {'(', ')', '[', ']'};
+    const char skpchrs[] = {' ', '\t', '\r', '\0'};
+    const char nonchainablechrs[] = {'(', ')', '[', ']', ',', '\n', ';'};
     enum class IdentifierType
     {
         Alpha,    // Alphabetic characters
@@ -145,52 +160,61 @@ std::string extract_identifier(std::string &line, char separator)
     std::string nextid;                              // The next identifier to extract
     size_t nextidend = 0;                            // The index of the next identifier's end in the line
     bool isstr = false;                              // Whether the identifier is a string
+    bool isescaped = false;                          // Whether the previous character was a backslash in a string
     bool iscomment = false;                          // Whether the identifier is a comment
 
     for (auto chr : line) // Iterate over each character in the line
     {
         if (iscomment)
         {
-            nextidend++;
+            // Keep the comment text and leave the line ending for the next identifier
             if (chr == '\n')
                 break;
+            nextidend++;
+            nextid += chr;
             continue;
         }
-        if (isunchainablechr(chr)) // Check if the character is unchainable
+        if (isunchainablechr(chr) && !isstr) // Check if the character is unchainable
         {
-            if (nextidend == 0)
+            if (nextid.empty())
             {
                 nextidend++;
                 nextid += chr;
             }
             break;
         }
-        if (isskpchr(chr) || isstr)
+        if (!isskpchr(chr) || isstr)
         {
             if (!iscomment)
             {
-                if (chr == '\"')
+                if (chr == '\"' && !isescaped)
                 {
                     if (isstr)
                     {
+                        // Keep the closing quote, it tells a terminated string from an unterminated one
                         nextidend++;
+                        nextid += chr;
                         break;
                     }
                     isstr = true;
                 }
-                else if (chr == '#')
+                else if (chr == '#' && !isstr)
                 {
-                    iscomment = true; // Assume the rest of the line is a comment
                     if (nextid.size() > 0)
                         break;
-                    else
-                        nextidend++;
+                    iscomment = true; // Assume the rest of the line is a comment
+                    nextidend++;
+                    nextid += chr;
                     continue;
                 }
                 if (isstr)
                 {
+                    // An unterminated string ends with its line, the line ending is left for the next identifier
+                    if (chr == '\n')
+                        break;
+                    isescaped = chr == '\\' && !isescaped;
                     nextidend++;
-                    nextidend += chr;
+                    nextid += chr;
                     continue;
                 }
             }
@@ -252,13 +276,102 @@ Token determine_token_type(const std::string &next_id)
 {
     TokenType tktype = static_cast<TokenType>(0);
     Token nexttk{TokenType::Invalid, next_id};
-    enum class TokenIdentifyMethod
+    auto isdigitchr = [](int chr) -> bool
     {
-        Number,         // Number
-        ReservedKeyword // Reserved keyword
+        return chr >= '0' && chr <= '9';
     };
     const int first_chr = next_id[0];
     const int second_chr = next_id.size() > 1 ? next_id[1] : ' ';
     if (first_chr == '\"')
-        return {TokenType::String, next_id};
-}
\ No newline at end of file
+    {
+        // A string is terminated by a closing quote that is not escaped
+        size_t backslashes = 0;
+        while (next_id.size() >= backslashes + 3 && next_id[next_id.size() - 2 - backslashes] == '\\')
+            backslashes++;
+        const bool terminated = next_id.size() >= 2 && next_id.back() == '\"' && backslashes % 2 == 0;
+        return {terminated ? TokenType::String : TokenType::Invalid, next_id};
+    }
+    if (first_chr == '#')
+        return {TokenType::Comment, next_id};
+    // A sign or a decimal point only starts a number when a digit follows it
+    if (isdigitchr(first_chr) || ((first_chr == '-' || first_chr == '.') && isdigitchr(second_chr)))
+        return {TokenType::Number, next_id};
+    if (next_id == "true" || next_id == "false")
+        return {TokenType::Bool, next_id};
+    // Reserved keywords, operators and punctuation are looked up in the identifiers table
+    for (; tktype != TokenType::Invalid; tktype = static_cast<TokenType>(static_cast<int>(tktype) + 1))
+    {
+        for (const auto &identifier : TokenIdentifier::tk_identifiers[static_cast<int>(tktype)].indentifiers)
+        {
+            if (identifier == next_id)
+            {
+                nexttk.type = tktype;
+                return nexttk;
+            }
+        }
+    }
+    if (first_chr == '_' || (first_chr >= 'A' && first_chr <= 'Z') || (first_chr >= 'a' && first_chr <= 'z'))
+        nexttk.type = TokenType::Identifier;
+    return nexttk;
+}
+
+std::vector<Token> tokenize(std::string_view src)
+{
+    std::vector<Token> tokens;
+    zylo::LineReader reader(src);
+    std::string_view srcline; // The current line, as a view into the source
+    while (reader.next(srcline))
+    {
+        // Work on a view of the line, so that trimming an identifier never copies the rest of it
+        std::string_view line = srcline;
+        const size_t lineno = reader.line_number();
+        while (!line.empty())
+        {
+            // The identifier starts after the blanks that `extract_identifier` skips
+            const size_t column = std::min(line.find_first_not_of(" \t\r"), line.size()) + srcline.size() - line.size() + 1;
+            const std::string nextid = extract_identifier(line);
+            if (nextid.empty())
+                continue;
+            Token nexttk = determine_token_type(nextid);
+            nexttk.line = lineno;
+            nexttk.column = column;
+            if (nexttk.type == TokenType::String)
+            {
+                nexttk.value.erase(0, 1); // Drop the opening quote
+                nexttk.value.pop_back();  // Drop the closing quote
+                process_escape_characters(nexttk.value);
+            }
+            else if (nexttk.type == TokenType::Comment)
+                nexttk.value.erase(nexttk.value.find_last_not_of(" \t\r") + 1); // Drop trailing blanks
+            tokens.push_back(nexttk);
+        }
+    }
+    tokens.push_back({TokenType::EndOfFile, "", reader.line_number() + 1, 1});
+    return tokens;
+}
+
+size_t report_invalid_tokens(const std::vector<Token> &tokens, zylo::Diagnostics &diagnostics, uint32_t file)
+{
+    size_t errcount = 0;
+    for (const auto &token : tokens)
+    {
+        if (token.type != TokenType::Invalid)
+            continue;
+        const zylo::Span span{static_cast<uint32_t>(token.line), static_cast<uint32_t>(token.column), static_cast<uint32_t>(token.value.size())};
+        if (token.value[0] == '\"')
+            diagnostics.report(zylo::DiagnosticCode::UnterminatedString, file, span);
+        else
+            diagnostics.report(zylo::DiagnosticCode::InvalidToken, file, span, {token.value});
+        errcount++;
+    }
+    return errcount;
+}
+
+zylo::Result<std::vector<Token>> tokenize(std::string_view src, zylo::Diagnostics &diagnostics, uint32_t file)
+{
+    std::vector<Token> tokens = tokenize(src);
+    const size_t firsterr = diagnostics.size();
+    if (report_invalid_tokens(tokens, diagnostics, file) > 0)
+        return zylo::ErrorRef{firsterr};
+    return tokens;
+}
@@ -19,8 +19,11 @@
 #define ZYLO_INTERNAL_LEXER_HXX
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
+#include "diagnostics.hxx"
+#include "result.hxx"
 
 /**
  * @enum TokenType
@@ -113,6 +116,23 @@ enum class TokenType
      */
     While,
 
+    /**
+     * @brief Represents an `import` keyword.
+     *
+     * This token type is used for the `import` keyword, which makes the declarations of another
+     * source file available. The keyword is followed by the path of the imported file as a string
+     * literal, relative to the directory of the importing file.
+     */
+    Import,
+
+    /**
+     * @brief Represents a `macro` keyword.
+     *
+     * This token type is used for the `macro` keyword, which defines a macro expanded on the
+     * token stream before parsing: `macro name(a, b) ( body )`.
+     */
+    Macro,
+
     /**
      * @brief Represents the equality operator (`==`).
      *
@@ -164,6 +184,13 @@ enum class TokenType
      */
     CloseBracket,
 
+    /**
+     * @brief Represents a comma (`,`).
+     *
+     * This token type is used for the comma, which separates parameters and arguments.
+     */
+    Comma,
+
     /**
      * @brief Represents an identifier.
      *
@@ -175,8 +202,9 @@ enum class TokenType
     /**
      * @brief Represents a comment.
      *
-     * This token type is used for tokens that represent comments in the source code,
-     * which are ignored by the lexer and compiler.
+     * This token type is used for tokens that represent comments in the source code. The
+     * token value holds the comment text, starting with `#`. Comments are kept in the token
+     * stream for tooling such as the formatter and are ignored by the compiler.
      */
     Comment,
 
@@ -260,12 +288,29 @@ struct Token
      * or analysis by the parser or other components.
      */
     std::string value;
+
+    /**
+     * @brief The line where the token starts.
+     *
+     * This member holds the 1-based line of the source code where the token begins, or 0 for
+     * tokens that were not produced from source code. It is used to point diagnostics and
+     * editor tooling at the token.
+     */
+    size_t line = 0;
+
+    /**
+     * @brief The column where the token starts.
+     *
+     * This member holds the 1-based column (in bytes) of the line where the token begins, or 0
+     * for tokens that were not produced from source code.
+     */
+    size_t column = 0;
 };
 
 /**
  * @brief Processes escape characters in a string.
  *
- * This function replaces escape sequences (such as `\n`, `\t`, etc.) in the provided
+ * This function replaces escape sequences (`\n`, `\t`, `\"` and `\\`) in the provided
  * string with their corresponding characters. It modifies the string in place.
  *
  * @param string A reference to the string to process. Escape sequences in this string
@@ -278,7 +323,8 @@ void process_escape_characters(std::string &string);
  *
  * This function converts characters in the string that are represented by escape sequences
  * (such as newline and tab) back into their escape sequence forms (e.g., `\n`, `\t`).
- * It modifies the string in place.
+ * It modifies the string in place. It is the inverse of `process_escape_characters`: a
+ * backslash that does not start an escape sequence, as in `\r` or `\x41`, is kept as is.
  *
  * @param string A reference to the string to unprocess. Characters that are currently
  *               represented as escape sequences will be converted back to their
@@ -293,11 +339,12 @@ void unprocess_escape_characters(std::string &string);
  * specified separator character. Identifiers are sequences of characters that are separated
  * by the separator.
  *
- * @param line A reference to the string from which to extract the identifier.
+ * @param line A reference to the view from which to extract the identifier. The view is advanced
+ *             past the identifier, without copying the rest of the line.
  * @param separator The character used to separate identifiers in the string. Default is a space.
  * @return The extracted identifier as a string.
  */
-std::string extract_identifier(std::string &line, char separator = ' ');
+std::string extract_identifier(std::string_view &line, char separator = ' ');
 
 /**
  * @brief Extracts words from a string into a vector.
@@ -326,12 +373,40 @@ Token determine_token_type(const std::string &next_id);
  *
  * This function processes the entire source code and breaks it down into tokens. Each token
  * represents a meaningful unit of the source code, and the sequence of tokens is returned
- * as a vector.
+ * as a vector. Every token records the line and column where it starts. The source code is
+ * only viewed, so it can come straight from a memory-mapped file.
  *
  * @param src The source code to tokenize.
  * @return A vector of `Token` objects representing th me tokens extracted from the source code.
  */
-std::vector<Token> tokenize(const std::string &src);
+std::vector<Token> tokenize(std::string_view src);
+
+/**
+ * @brief Reports the invalid tokens of a token stream to a diagnostics buffer.
+ *
+ * A string literal left open at the end of its line is an invalid token, reported as an
+ * unterminated string.
+ *
+ * @param tokens The token stream to check.
+ * @param diagnostics The diagnostics buffer of the compilation.
+ * @param file The index of the file the tokens come from in `diagnostics`.
+ * @return The number of invalid tokens found.
+ */
+size_t report_invalid_tokens(const std::vector<Token> &tokens, zylo::Diagnostics &diagnostics, uint32_t file);
+
+/**
+ * @brief Tokenizes the source code, reporting lexical errors to a diagnostics buffer.
+ *
+ * This function tokenizes the source code like `tokenize` and reports every invalid token to
+ * the given diagnostics buffer. Lexing goes on after an error, so all the errors of the source
+ * code are reported in a single pass.
+ *
+ * @param src The source code to tokenize.
+ * @param diagnostics The diagnostics buffer of the compilation.
+ * @param file The index of the file being tokenized in `diagnostics`.
+ * @return The tokens extracted from the source code, or a reference to the first error reported.
+ */
+zylo::Result<std::vector<Token>> tokenize(std::string_view src, zylo::Diagnostics &diagnostics, uint32_t file);
 
 /**
  * @brief Overload of the stream insertion operator to print a token.
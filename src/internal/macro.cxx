@@ -0,0 +1,363 @@
+/**
+ * @file macro.cxx
+ * @brief Implementation of the macro expander of the Zylo programming language.
+ *
+ * This file contains the implementation of the `MacroExpander` class declared in `macro.hxx`.
+ * Local names of an expansion are renamed by appending `$` and a number unique to the expansion.
+ * `$` can never appear in an identifier written in source code, so renamed names cannot clash
+ * with user names.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include "macro.hxx"
+#include "constants.hxx"
+
+namespace
+{
+    /**
+     * @brief Hashes a sequence of bytes into a running 64-bit FNV-1a hash.
+     *
+     * @param hash The hash of the data hashed so far.
+     * @param data The bytes to hash.
+     * @param size The number of bytes to hash.
+     * @return The updated hash.
+     */
+    uint64_t hash_bytes(uint64_t hash, const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t byteidx = 0; byteidx < size; byteidx++)
+        {
+            hash ^= bytes[byteidx];
+            hash *= 1099511628211ULL; // FNV-1a prime
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Hashes a string into a running hash, including its size so that strings stay apart.
+     *
+     * @param hash The hash of the data hashed so far.
+     * @param string The string to hash.
+     * @return The updated hash.
+     */
+    uint64_t hash_string(uint64_t hash, const std::string &string)
+    {
+        const uint64_t size = string.size();
+        return hash_bytes(hash_bytes(hash, &size, sizeof(size)), string.data(), string.size());
+    }
+
+    /**
+     * @brief Hashes a sequence of tokens (types and values) into a running hash.
+     *
+     * @param hash The hash of the data hashed so far.
+     * @param tokens The tokens to hash.
+     * @return The updated hash.
+     */
+    uint64_t hash_tokens(uint64_t hash, const std::vector<Token> &tokens)
+    {
+        for (const auto &token : tokens)
+        {
+            const unsigned char type = static_cast<unsigned char>(token.type);
+            hash = hash_string(hash_bytes(hash, &type, 1), token.value);
+        }
+        return hash_bytes(hash, "", 1); // Terminate the sequence
+    }
+
+    /**
+     * @brief Builds the span of a token.
+     *
+     * @param token The token.
+     * @return The span covering the token.
+     */
+    zylo::Span span_of(const Token &token)
+    {
+        return {static_cast<uint32_t>(token.line), static_cast<uint32_t>(token.column), static_cast<uint32_t>(token.value.size())};
+    }
+
+    /**
+     * @brief Determines whether a token is a line ending (as opposed to `;`).
+     *
+     * @param token The token.
+     * @return `true` if the token ends a line.
+     */
+    bool is_newline(const Token &token)
+    {
+        return token.type == TokenType::EndOfLine && token.value == "\n";
+    }
+} // namespace
+
+zylo::Result<std::vector<Token>> zylo::MacroExpander::expand(const std::vector<Token> &tokens, Diagnostics &diagnostics, uint32_t file)
+{
+    macros.clear();
+    recorders.clear();
+    const size_t firsterr = diagnostics.size();
+    std::vector<Token> output;
+    output.reserve(tokens.size());
+    expand_range(tokens, output, 0, diagnostics, file);
+    if (diagnostics.size() > firsterr)
+        return ErrorRef{firsterr};
+    return output;
+}
+
+size_t zylo::MacroExpander::cache_size() const
+{
+    return cache.size();
+}
+
+size_t zylo::MacroExpander::define(const std::vector<Token> &tokens, size_t tkidx, Diagnostics &diagnostics, uint32_t file)
+{
+    const Token &keyword = tokens[tkidx];
+    size_t idx = tkidx + 1;
+    std::string name;
+    auto fail = [&]() -> size_t
+    {
+        diagnostics.report(DiagnosticCode::InvalidMacro, file, span_of(keyword), {name});
+        // Skip the rest of the definition line
+        while (idx < tokens.size() && !is_newline(tokens[idx]) && tokens[idx].type != TokenType::EndOfFile)
+            idx++;
+        return idx;
+    };
+
+    if (idx >= tokens.size() || tokens[idx].type != TokenType::Identifier)
+        return fail();
+    name = tokens[idx++].value;
+    if (idx >= tokens.size() || tokens[idx].type != TokenType::OpenParen)
+        return fail();
+    Macro macro;
+    for (idx++; idx < tokens.size() && tokens[idx].type != TokenType::CloseParen;)
+    {
+        if (tokens[idx].type != TokenType::Identifier)
+            return fail();
+        macro.parameters.push_back(tokens[idx++].value);
+        if (idx < tokens.size() && tokens[idx].type == TokenType::Comma)
+            idx++;
+        else if (idx < tokens.size() && tokens[idx].type != TokenType::CloseParen)
+            return fail();
+    }
+    if (++idx >= tokens.size() || tokens[idx].type != TokenType::OpenParen)
+        return fail();
+
+    // The body ends at the parenthesis matching the one opening it
+    const size_t bodystart = idx + 1;
+    size_t nesting = 0;
+    for (; idx < tokens.size() && tokens[idx].type != TokenType::EndOfFile; idx++)
+    {
+        if (tokens[idx].type == TokenType::OpenParen)
+            nesting++;
+        else if (tokens[idx].type == TokenType::CloseParen && --nesting == 0)
+            break;
+    }
+    if (idx >= tokens.size() || tokens[idx].type != TokenType::CloseParen)
+        return fail();
+    for (size_t bodyidx = bodystart; bodyidx < idx; bodyidx++)
+    {
+        if (tokens[bodyidx].type != TokenType::Comment)
+            macro.body.push_back(tokens[bodyidx]);
+    }
+
+    for (size_t bodyidx = 0; bodyidx + 1 < macro.body.size(); bodyidx++)
+    {
+        const TokenType type = macro.body[bodyidx].type;
+        const Token &declared = macro.body[bodyidx + 1];
+        if ((type == TokenType::Var || type == TokenType::Const || type == TokenType::Func) &&
+            declared.type == TokenType::Identifier &&
+            std::find(macro.parameters.begin(), macro.parameters.end(), declared.value) == macro.parameters.end() &&
+            std::find(macro.locals.begin(), macro.locals.end(), declared.value) == macro.locals.end())
+            macro.locals.push_back(declared.value);
+    }
+
+    uint64_t hash = hash_string(14695981039346656037ULL, name); // FNV-1a offset basis
+    for (const auto &parameter : macro.parameters)
+        hash = hash_string(hash, parameter);
+    macro.hash = hash_tokens(hash, macro.body);
+    macros[name] = std::move(macro);
+    return idx + 1;
+}
+
+bool zylo::MacroExpander::expand_range(const std::vector<Token> &tokens, std::vector<Token> &output, int depth, Diagnostics &diagnostics, uint32_t file)
+{
+    for (size_t tkidx = 0; tkidx < tokens.size();)
+    {
+        const Token &token = tokens[tkidx];
+        // Definitions are recognized in the tokens of the module, not in the tokens produced by an expansion
+        if (token.type == TokenType::Macro && depth == 0)
+        {
+            tkidx = define(tokens, tkidx, diagnostics, file);
+            continue;
+        }
+        const bool isinvocation = token.type == TokenType::Identifier && tkidx + 1 < tokens.size() && tokens[tkidx + 1].type == TokenType::OpenParen;
+        const auto macro = isinvocation ? macros.find(token.value) : macros.end();
+        // The expansion being computed depends on this name, whether it names a macro or not
+        if (isinvocation)
+            record_dependency({token.value, macro != macros.end() ? macro->second.hash : 0});
+        if (macro == macros.end())
+        {
+            output.push_back(token);
+            tkidx++;
+            continue;
+        }
+
+        // Split the arguments at the commas that are not nested in brackets
+        std::vector<std::vector<Token>> arguments;
+        std::vector<Token> argument;
+        size_t nesting = 0;
+        size_t argidx = tkidx + 2;
+        bool closed = false;
+        for (; argidx < tokens.size() && tokens[argidx].type != TokenType::EndOfFile; argidx++)
+        {
+            const Token &argtk = tokens[argidx];
+            if (nesting == 0 && argtk.type == TokenType::CloseParen)
+            {
+                closed = true;
+                break;
+            }
+            // A stray closing bracket ends the arguments, which are then reported as unterminated
+            if (nesting == 0 && argtk.type == TokenType::CloseBracket)
+                break;
+            if (nesting == 0 && argtk.type == TokenType::Comma)
+            {
+                arguments.push_back(std::move(argument));
+                argument.clear();
+                continue;
+            }
+            if (argtk.type == TokenType::OpenParen || argtk.type == TokenType::OpenBracket)
+                nesting++;
+            else if (argtk.type == TokenType::CloseParen || argtk.type == TokenType::CloseBracket)
+                nesting--;
+            if (argtk.type != TokenType::Comment && !is_newline(argtk))
+                argument.push_back(argtk);
+        }
+        if (!argument.empty() || !arguments.empty())
+            arguments.push_back(std::move(argument));
+        const std::vector<std::string> &parameters = macro->second.parameters;
+        if (!closed || arguments.size() != parameters.size())
+        {
+            diagnostics.report(DiagnosticCode::MacroArguments, file, span_of(token), {token.value, std::to_string(parameters.size())});
+            tkidx = closed ? argidx + 1 : argidx;
+            continue;
+        }
+        if (depth >= MACRO_EXPANSION_DEPTH_LIMIT)
+        {
+            diagnostics.report(DiagnosticCode::MacroTooDeep, file, span_of(token), {token.value});
+            return false;
+        }
+
+        std::string key(reinterpret_cast<const char *>(&macro->second.hash), sizeof(uint64_t));
+        for (const auto &argtokens : arguments)
+        {
+            const uint64_t arghash = hash_tokens(14695981039346656037ULL, argtokens); // FNV-1a offset basis
+            key.append(reinterpret_cast<const char *>(&arghash), sizeof(uint64_t));
+        }
+        const size_t outputstart = output.size();
+        const auto cached = cache.find(key);
+        if (cached != cache.end() && is_current(cached->second))
+        {
+            for (const auto &dependency : cached->second.dependencies)
+                record_dependency(dependency);
+            append_expansion(cached->second, output);
+        }
+        else
+        {
+            const size_t firstsuffix = nextsuffix;
+            const std::string suffix = "$" + std::to_string(nextsuffix++);
+            std::vector<Token> substituted;
+            for (const auto &bodytk : macro->second.body)
+            {
+                if (bodytk.type == TokenType::Identifier)
+                {
+                    const auto parameter = std::find(parameters.begin(), parameters.end(), bodytk.value);
+                    if (parameter != parameters.end())
+                    {
+                        const auto &argtokens = arguments[parameter - parameters.begin()];
+                        substituted.insert(substituted.end(), argtokens.begin(), argtokens.end());
+                        continue;
+                    }
+                    const std::vector<std::string> &locals = macro->second.locals;
+                    if (std::find(locals.begin(), locals.end(), bodytk.value) != locals.end())
+                    {
+                        substituted.push_back(bodytk);
+                        substituted.back().value += suffix;
+                        continue;
+                    }
+                }
+                substituted.push_back(bodytk);
+            }
+            // Expanded tokens are scanned again for the invocations they contain
+            std::vector<Token> expansion;
+            recorders.emplace_back();
+            const bool expanded = expand_range(substituted, expansion, depth + 1, diagnostics, file);
+            std::vector<Dependency> dependencies = std::move(recorders.back());
+            recorders.pop_back();
+            if (!expanded)
+            {
+                if (depth > 0)
+                    return false;
+                tkidx = argidx + 1;
+                continue;
+            }
+            for (const auto &dependency : dependencies)
+                record_dependency(dependency);
+            output.insert(output.end(), expansion.begin(), expansion.end());
+            cache.insert_or_assign(std::move(key), Expansion{std::move(expansion), firstsuffix, nextsuffix, std::move(dependencies)});
+        }
+        if (depth == 0)
+        {
+            for (size_t outidx = outputstart; outidx < output.size(); outidx++)
+            {
+                output[outidx].line = token.line;
+                output[outidx].column = token.column;
+            }
+        }
+        tkidx = argidx + 1;
+    }
+    return true;
+}
+
+void zylo::MacroExpander::record_dependency(const Dependency &dependency)
+{
+    if (recorders.empty())
+        return;
+    std::vector<Dependency> &dependencies = recorders.back();
+    for (const auto &recorded : dependencies)
+    {
+        if (recorded.name == dependency.name)
+            return;
+    }
+    dependencies.push_back(dependency);
+}
+
+bool zylo::MacroExpander::is_current(const Expansion &expansion) const
+{
+    for (const auto &dependency : expansion.dependencies)
+    {
+        const auto macro = macros.find(dependency.name);
+        if ((macro != macros.end() ? macro->second.hash : 0) != dependency.hash)
+            return false;
+    }
+    return true;
+}
+
+void zylo::MacroExpander::append_expansion(const Expansion &expansion, std::vector<Token> &output)
+{
+    // Give the expansion, and every expansion nested in it, fresh suffixes
+    std::unordered_map<size_t, std::string> suffixes;
+    for (Token token : expansion.tokens)
+    {
+        const size_t suffixidx = token.type == TokenType::Identifier ? token.value.rfind('$') : std::string::npos;
+        if (suffixidx != std::string::npos)
+        {
+            const char *digits = token.value.c_str() + suffixidx + 1;
+            char *digitsend = nullptr;
+            const size_t number = std::strtoull(digits, &digitsend, 10);
+            if (digitsend != digits && *digitsend == '\0' && number >= expansion.firstsuffix && number < expansion.endsuffix)
+            {
+                std::string &suffix = suffixes[number];
+                if (suffix.empty())
+                    suffix = "$" + std::to_string(nextsuffix++);
+                token.value.replace(suffixidx, std::string::npos, suffix);
+            }
+        }
+        output.push_back(std::move(token));
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file macro.hxx
+ * @brief Defines the macro expander of the Zylo programming language.
+ *
+ * This file contains the declaration of the `MacroExpander` class, which runs between the lexer
+ * and the parser. It removes macro definitions from a token stream and replaces every macro
+ * invocation with the body of the macro, its parameters substituted by the tokens of the
+ * arguments. A macro is defined with `macro name(a, b) ( body )` and invoked with `name(x, y)`;
+ * it is visible from its definition to the end of the module.
+ *
+ * Expansion is hygienic: names declared inside a macro body (after `zylo`, `const` or `func`) are
+ * renamed for every expansion, so they can neither clash with nor capture names of the code the
+ * macro is expanded into. Expansions are cached by the hash of the macro definition and the hashes
+ * of the arguments, so repeated invocations are copied instead of being expanded again. A cached
+ * expansion is only reused while the macros it invoked, directly or through its arguments, are
+ * defined as they were when it was computed.
+ */
+
+#ifndef ZYLO_INTERNAL_MACRO_HXX // ZYLO_INTERNAL_MACRO_HXX
+
+#define ZYLO_INTERNAL_MACRO_HXX
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "lexer.hxx"
+#include "diagnostics.hxx"
+#include "result.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @class MacroExpander
+     * @brief Expands the macros of token streams.
+     *
+     * A `MacroExpander` keeps its expansion cache between calls to `expand`, so one expander should
+     * be used for all the modules of a program. It is not thread-safe.
+     */
+    class MacroExpander
+    {
+    public:
+        /**
+         * @brief Expands the macros of a token stream.
+         *
+         * Every macro definition is removed from the token stream and every invocation is replaced
+         * by its expansion. Expanded tokens take the position of the invocation they come from.
+         * Macros defined by previous calls are not visible.
+         *
+         * @param tokens The token stream to expand.
+         * @param diagnostics The diagnostics buffer of the compilation.
+         * @param file The index of the file the tokens come from in `diagnostics`.
+         * @return The expanded token stream, or a reference to the first error reported.
+         */
+        Result<std::vector<Token>> expand(const std::vector<Token> &tokens, Diagnostics &diagnostics, uint32_t file);
+
+        /**
+         * @brief Retrieves the number of cached expansions.
+         *
+         * @return The number of expansions in the cache.
+         */
+        size_t cache_size() const;
+
+    private:
+        /**
+         * @struct Macro
+         * @brief Represents a macro definition.
+         */
+        struct Macro
+        {
+            std::vector<std::string> parameters; // The names of the parameters.
+            std::vector<std::string> locals;     // The names declared in the body, renamed on expansion.
+            std::vector<Token> body;             // The tokens of the body.
+            uint64_t hash;                       // The hash of the whole definition.
+        };
+
+        /**
+         * @struct Dependency
+         * @brief A name looked up while computing an expansion, along with what it named then.
+         */
+        struct Dependency
+        {
+            std::string name; // The name invoked in the expansion.
+            uint64_t hash;    // The hash of the macro the name was bound to, 0 if it was not a macro.
+        };
+
+        /**
+         * @struct Expansion
+         * @brief A cached expansion, along with the range of suffixes it gave to local names.
+         *
+         * Only the suffixes in the range belong to the expansion. Other suffixed names come from
+         * the arguments, such as locals of an enclosing expansion, and must be kept as they are.
+         * The expansion is only reused while every name it looked up, in its body, its arguments
+         * or its nested expansions, still names the same macro (or still names none).
+         */
+        struct Expansion
+        {
+            std::vector<Token> tokens;            // The tokens of the expansion.
+            size_t firstsuffix;                   // The first suffix created by the expansion.
+            size_t endsuffix;                     // The suffix following the last one created by the expansion.
+            std::vector<Dependency> dependencies; // The names looked up while computing the expansion.
+        };
+
+        /**
+         * @brief Parses the macro definition starting at a `macro` keyword.
+         *
+         * @param tokens The token stream.
+         * @param tkidx The index of the `macro` keyword.
+         * @param diagnostics The buffer where a malformed definition is reported.
+         * @param file The index of the file in `diagnostics`.
+         * @return The index of the first token after the definition.
+         */
+        size_t define(const std::vector<Token> &tokens, size_t tkidx, Diagnostics &diagnostics, uint32_t file);
+
+        /**
+         * @brief Expands the macro invocations of a range of tokens.
+         *
+         * @param tokens The tokens to expand.
+         * @param output The token stream receiving the expanded tokens.
+         * @param depth The number of expansions the tokens are nested in.
+         * @param diagnostics The buffer where errors are reported.
+         * @param file The index of the file in `diagnostics`.
+         * @return `false` if the depth limit was reached, in which case the expansion is abandoned.
+         */
+        bool expand_range(const std::vector<Token> &tokens, std::vector<Token> &output, int depth, Diagnostics &diagnostics, uint32_t file);
+
+        /**
+         * @brief Records a name looked up by the expansion being computed, if any.
+         *
+         * @param dependency The name and the hash of the macro it names.
+         */
+        void record_dependency(const Dependency &dependency);
+
+        /**
+         * @brief Checks whether a cached expansion is still valid for the current macros.
+         *
+         * @param expansion The cached expansion.
+         * @return `true` if every name the expansion looked up still names the same macro.
+         */
+        bool is_current(const Expansion &expansion) const;
+
+        /**
+         * @brief Appends a cached expansion to a token stream, renaming its local names.
+         *
+         * Names carrying a suffix created by the expansion get fresh suffixes; other names are
+         * copied unchanged.
+         *
+         * @param expansion The cached expansion.
+         * @param output The token stream receiving the expansion.
+         */
+        void append_expansion(const Expansion &expansion, std::vector<Token> &output);
+
+        std::unordered_map<std::string, Macro> macros;       // The macros of the token stream being expanded.
+        std::unordered_map<std::string, Expansion> cache;    // The cached expansions, by definition and argument hashes.
+        size_t nextsuffix = 0;                               // The suffix given to the local names of the next expansion.
+        std::vector<std::vector<Dependency>> recorders;      // The dependencies of the expansions being computed, innermost last.
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_INTERNAL_MACRO_HXX
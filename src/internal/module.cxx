@@ -0,0 +1,170 @@
+/**
+ * @file module.cxx
+ * @brief Implementation of the module loader of the Zylo programming language.
+ *
+ * This file contains the implementation of the functions declared in `module.hxx`. Modules are
+ * identified by their canonical path, which is what makes a module imported through different
+ * relative paths load only once.
+ */
+
+#include <filesystem>
+#include <unordered_map>
+#include <utility>
+#include "module.hxx"
+#include "parallel.hxx"
+
+namespace
+{
+    /**
+     * @struct Node
+     * @brief Represents a module while the dependency graph is being built.
+     */
+    struct Node
+    {
+        std::string path;                                 // The path of the module, as shown in messages.
+        zylo::SourceCache::Tokens tokens;                 // The token stream of the module, once loaded.
+        std::vector<std::pair<size_t, zylo::Span>> edges; // The imported modules and the span of each import.
+        uint32_t importer = 0;                            // The file index of the module that first imported this one.
+        zylo::Span span;                                  // The span of that first import.
+    };
+
+    /**
+     * @brief Orders the modules of a graph so that every module comes after its imports.
+     *
+     * @param nodes The modules of the graph.
+     * @param nodeidx The index of the module to visit.
+     * @param states The visit state of each module: 0 unvisited, 1 being visited, 2 visited.
+     * @param order The modules visited so far, in dependency order.
+     * @param files The file index of each module in `diagnostics`.
+     * @param diagnostics The buffer where import cycles are reported.
+     */
+    void order_modules(const std::vector<Node> &nodes, size_t nodeidx, std::vector<char> &states,
+                       std::vector<size_t> &order, const std::vector<uint32_t> &files, zylo::Diagnostics &diagnostics)
+    {
+        states[nodeidx] = 1;
+        for (const auto &edge : nodes[nodeidx].edges)
+        {
+            if (states[edge.first] == 1)
+                diagnostics.report(zylo::DiagnosticCode::CyclicImport, files[nodeidx], edge.second, {nodes[edge.first].path});
+            else if (states[edge.first] == 0)
+                order_modules(nodes, edge.first, states, order, files, diagnostics);
+        }
+        states[nodeidx] = 2;
+        order.push_back(nodeidx);
+    }
+
+    /**
+     * @brief Builds the dependency graph of a program and returns its modules in dependency order.
+     *
+     * @param root The main module of the program. Its tokens are loaded from its path if not set.
+     * @param rootkey The key identifying the main module.
+     * @param cache The cache providing the token streams of the modules.
+     * @param diagnostics The diagnostics buffer of the compilation.
+     * @return The modules in dependency order, or a reference to the first error reported.
+     */
+    zylo::Result<std::vector<zylo::Module>> load_graph(Node root, const std::string &rootkey, zylo::SourceCache &cache, zylo::Diagnostics &diagnostics)
+    {
+        const size_t firsterr = diagnostics.size();
+        std::vector<Node> nodes{std::move(root)};                       // The modules of the graph
+        std::vector<uint32_t> files{0};                                 // The file index of each module in `diagnostics`
+        std::unordered_map<std::string, size_t> nodeidxs{{rootkey, 0}}; // The index of each module, by canonical path
+        std::vector<size_t> wave{0};                                    // The modules discovered in the last pass
+
+        while (!wave.empty())
+        {
+            // Read and lex the files of the wave in parallel; the modules may import each other,
+            // but loading a file does not depend on any other module
+            zylo::parallel_for(wave.size(), [&](size_t waveidx)
+            {
+                Node &node = nodes[wave[waveidx]];
+                if (!node.tokens)
+                    node.tokens = cache.load(node.path);
+            });
+
+            std::vector<size_t> nextwave;
+            for (const size_t nodeidx : wave)
+            {
+                const uint32_t file = diagnostics.add_file(nodes[nodeidx].path);
+                files[nodeidx] = file;
+                const zylo::SourceCache::Tokens tokens = nodes[nodeidx].tokens;
+                if (!tokens)
+                {
+                    if (nodeidx == 0)
+                        diagnostics.report(zylo::DiagnosticCode::CouldNotOpenFile, file);
+                    else
+                        diagnostics.report(zylo::DiagnosticCode::ModuleNotFound, nodes[nodeidx].importer, nodes[nodeidx].span, {nodes[nodeidx].path});
+                    continue;
+                }
+                report_invalid_tokens(*tokens, diagnostics, file);
+
+                const std::filesystem::path basedir = std::filesystem::path(nodes[nodeidx].path).parent_path();
+                for (size_t tkidx = 0; tkidx < tokens->size(); tkidx++)
+                {
+                    const Token &token = (*tokens)[tkidx];
+                    if (token.type != TokenType::Import)
+                        continue;
+                    if (tkidx + 1 >= tokens->size() || (*tokens)[tkidx + 1].type != TokenType::String)
+                    {
+                        const zylo::Span span{static_cast<uint32_t>(token.line), static_cast<uint32_t>(token.column), static_cast<uint32_t>(token.value.size())};
+                        diagnostics.report(zylo::DiagnosticCode::InvalidImport, file, span);
+                        continue;
+                    }
+                    const Token &pathtk = (*tokens)[++tkidx];
+                    const zylo::Span span{static_cast<uint32_t>(pathtk.line), static_cast<uint32_t>(pathtk.column), static_cast<uint32_t>(pathtk.value.size())};
+                    const std::filesystem::path path = (basedir / pathtk.value).lexically_normal();
+                    std::error_code errcode;
+                    std::filesystem::path key = std::filesystem::weakly_canonical(path, errcode);
+                    if (errcode)
+                        key = path;
+
+                    auto found = nodeidxs.find(key.string());
+                    if (found == nodeidxs.end())
+                    {
+                        found = nodeidxs.emplace(key.string(), nodes.size()).first;
+                        nodes.push_back({path.string(), nullptr, {}, file, span});
+                        files.push_back(0);
+                        nextwave.push_back(found->second);
+                    }
+                    nodes[nodeidx].edges.emplace_back(found->second, span);
+                }
+            }
+            wave = std::move(nextwave);
+        }
+        if (diagnostics.size() > firsterr)
+            return zylo::ErrorRef{firsterr};
+
+        std::vector<char> states(nodes.size(), 0);
+        std::vector<size_t> order;
+        order_modules(nodes, 0, states, order, files, diagnostics);
+        if (diagnostics.size() > firsterr)
+            return zylo::ErrorRef{firsterr};
+
+        std::vector<size_t> positions(nodes.size()); // The position of each module in the result
+        for (size_t position = 0; position < order.size(); position++)
+            positions[order[position]] = position;
+        std::vector<zylo::Module> modules;
+        modules.reserve(order.size());
+        for (const size_t nodeidx : order)
+        {
+            zylo::Module module{nodes[nodeidx].path, nodes[nodeidx].tokens, {}};
+            for (const auto &edge : nodes[nodeidx].edges)
+                module.imports.push_back(positions[edge.first]);
+            modules.push_back(std::move(module));
+        }
+        return modules;
+    }
+} // namespace
+
+zylo::Result<std::vector<zylo::Module>> zylo::load_modules(const std::string &path, SourceCache &cache, Diagnostics &diagnostics)
+{
+    std::error_code errcode;
+    std::filesystem::path key = std::filesystem::weakly_canonical(path, errcode);
+    if (errcode)
+        key = path;
+    return load_graph({path, nullptr, {}, 0, Span()}, key.string(), cache, diagnostics);
+}
+
+zylo::Result<std::vector<zylo::Module>> zylo::load_modules(const std::string &name, SourceCache::Tokens tokens, SourceCache &cache, Diagnostics &diagnostics)
+{
+    return load_graph({name, std::move(tokens), {}, 0, Span()}, name, cache, diagnostics);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file module.hxx
+ * @brief Defines the module loader of the Zylo programming language.
+ *
+ * This file contains the declaration of the module loader, which follows the `import` statements
+ * of a program to find every source file it depends on. The loader builds the dependency graph
+ * breadth first, one wave per import level: the files of the modules first imported in the same
+ * wave are read and lexed in parallel, then their imports are collected on the calling thread.
+ * Modules of a wave may still import each other; the dependency order is only established once
+ * the whole graph is known. Every module is loaded once per graph, even when it is imported
+ * by several modules (diamond imports), and its token stream comes from a `SourceCache`, so a
+ * module whose contents did not change is never processed again.
+ */
+
+#ifndef ZYLO_INTERNAL_MODULE_HXX // ZYLO_INTERNAL_MODULE_HXX
+
+#define ZYLO_INTERNAL_MODULE_HXX
+
+#include <string>
+#include <vector>
+#include "cache.hxx"
+#include "diagnostics.hxx"
+#include "result.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @struct Module
+     * @brief Represents a source file of a program.
+     */
+    struct Module
+    {
+        std::string path;            // The path of the module, or the name of an in-memory program.
+        SourceCache::Tokens tokens;  // The token stream of the module.
+        std::vector<size_t> imports; // The indices of the modules imported by this one.
+    };
+
+    /**
+     * @brief Loads a program stored in a file along with all the modules it imports.
+     *
+     * @param path The path of the main file of the program.
+     * @param cache The cache providing the token streams of the modules.
+     * @param diagnostics The diagnostics buffer of the compilation.
+     * @return The modules of the program, ordered so that every module comes after the modules it
+     * imports (the main file is therefore last), or a reference to the first error reported.
+     */
+    Result<std::vector<Module>> load_modules(const std::string &path, SourceCache &cache, Diagnostics &diagnostics);
+
+    /**
+     * @brief Loads an in-memory program along with all the modules it imports.
+     *
+     * The modules imported by an in-memory program are resolved relative to the current directory.
+     *
+     * @param name The name used to refer to the program in error messages.
+     * @param tokens The token stream of the program.
+     * @param cache The cache providing the token streams of the imported modules.
+     * @param diagnostics The diagnostics buffer of the compilation.
+     * @return The modules of the program, ordered so that every module comes after the modules it
+     * imports, or a reference to the first error reported.
+     */
+    Result<std::vector<Module>> load_modules(const std::string &name, SourceCache::Tokens tokens, SourceCache &cache, Diagnostics &diagnostics);
+
+} // namespace zylo
+
+#endif // ZYLO_INTERNAL_MODULE_HXX
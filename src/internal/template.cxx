@@ -0,0 +1,67 @@
+/**
+ * @file template.cxx
+ * @brief Implementation of the template engine of the Zylo programming language.
+ *
+ * This file contains the implementation of the template engine declared in `template.hxx`.
+ * Lines are counted as the template is scanned, so positions are known without a second pass.
+ */
+
+#include <cstring>
+#include "template.hxx"
+#include "lexer.hxx"
+
+zylo::Result<size_t> zylo::render_template(std::string_view input, BufferedWriter &output, Diagnostics &diagnostics, uint32_t file)
+{
+    const size_t firsterr = diagnostics.size();
+    size_t blocks = 0;    // The number of blocks processed
+    size_t pos = 0;       // The index of the first character not processed yet
+    size_t line = 1;      // The line of `pos`
+    size_t linestart = 0; // The index where the line of `pos` starts
+    auto skip = [&](size_t end)
+    {
+        for (const char *newline; (newline = static_cast<const char *>(std::memchr(input.data() + pos, '\n', end - pos))) != nullptr;)
+        {
+            pos = static_cast<size_t>(newline - input.data()) + 1;
+            linestart = pos;
+            line++;
+        }
+        pos = end;
+    };
+
+    while (pos < input.size())
+    {
+        const size_t open = input.find(TEMPLATE_BLOCK_OPEN, pos);
+        const size_t literalend = open == std::string_view::npos ? input.size() : open;
+        output.write(input.data() + pos, literalend - pos);
+        skip(literalend);
+        if (open == std::string_view::npos)
+            break;
+
+        const size_t blockstart = open + TEMPLATE_BLOCK_OPEN.size();
+        const size_t close = input.find(TEMPLATE_BLOCK_CLOSE, blockstart);
+        if (close == std::string_view::npos)
+        {
+            const Span span{static_cast<uint32_t>(line), static_cast<uint32_t>(open - linestart + 1), static_cast<uint32_t>(TEMPLATE_BLOCK_OPEN.size())};
+            diagnostics.report(DiagnosticCode::UnterminatedTemplate, file, span);
+            break;
+        }
+
+        // The block writes its output in place once it runs; positions are moved into the template
+        const size_t blockline = line;
+        const size_t blockcolumn = blockstart - linestart + 1;
+        std::vector<Token> tokens = tokenize(input.substr(blockstart, close - blockstart));
+        for (auto &token : tokens)
+        {
+            if (token.line == 1)
+                token.column += blockcolumn - 1;
+            token.line += blockline - 1;
+        }
+        report_invalid_tokens(tokens, diagnostics, file);
+        blocks++;
+        skip(close);
+        pos = close + TEMPLATE_BLOCK_CLOSE.size();
+    }
+    if (diagnostics.size() > firsterr)
+        return ErrorRef{firsterr};
+    return blocks;
+}
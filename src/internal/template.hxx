@@ -0,0 +1,51 @@
+/**
+ * @file template.hxx
+ * @brief Defines the template engine of the Zylo programming language.
+ *
+ * This file contains the declaration of the template engine, which processes text files with
+ * embedded Zylo code. Literal text is copied to the output untouched, and every block of code
+ * enclosed in `<?zylo` and `?>` goes through the language pipeline in place. The input is read
+ * from a single view (typically a memory-mapped file) and literal spans are copied straight from
+ * it into a `BufferedWriter`, so templates of any size are processed with constant memory.
+ */
+
+#ifndef ZYLO_INTERNAL_TEMPLATE_HXX // ZYLO_INTERNAL_TEMPLATE_HXX
+
+#define ZYLO_INTERNAL_TEMPLATE_HXX
+
+#include <string_view>
+#include "diagnostics.hxx"
+#include "io.hxx"
+#include "result.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @brief The delimiter opening a block of Zylo code in a template.
+     */
+    constexpr std::string_view TEMPLATE_BLOCK_OPEN = "<?zylo";
+
+    /**
+     * @brief The delimiter closing a block of Zylo code in a template.
+     */
+    constexpr std::string_view TEMPLATE_BLOCK_CLOSE = "?>";
+
+    /**
+     * @brief Processes a template, writing the result to a writer.
+     *
+     * Literal text is written as it is found, so the output is produced while the template is
+     * scanned. Blocks of code are tokenized with positions relative to the template, so
+     * diagnostics point into the template file.
+     *
+     * @param input The contents of the template.
+     * @param output The writer receiving the result.
+     * @param diagnostics The diagnostics buffer of the run.
+     * @param file The index of the template file in `diagnostics`.
+     * @return The number of blocks of code processed, or a reference to the first error reported.
+     */
+    Result<size_t> render_template(std::string_view input, BufferedWriter &output, Diagnostics &diagnostics, uint32_t file);
+
+} // namespace zylo
+
+#endif // ZYLO_INTERNAL_TEMPLATE_HXX
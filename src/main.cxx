@@ -2,15 +2,65 @@
  * @file main.cxx
  * @brief Main entry point for the Zylo application.
  *
- * This file contains the main function for the Zylo application, which initializes the terminal,
+ * This file contains the main function for the Zylo application. When launched with a script
+ * (`zylolang script.zy [args...]`), an inline program (`zylolang -e 'code'`) or with a program
+ * piped through the standard input (`zylolang -` or a redirected standard input), it runs that
+ * program without any terminal initialization; `zylolang template <file> [output]` processes a
+ * template file and `zylolang fmt [--check] [files...]` formats source files. The `--json` option,
+ * given before the program, prints diagnostics as JSON. Otherwise it initializes the terminal,
  * displays information about the Zylo language, and handles user input.
  */
 
 #include "terminal.hxx"
+#include "runner.hxx"
 #include <iostream>
+#include <string>
+#include <vector>
 
-int main()
+int main(int argc, char *argv[])
 {
+    zylo_runner::Options options;
+    int argidx = 1; // The index of the first argument that is not an option of zylolang itself
+    for (; argidx < argc && std::string(argv[argidx]) == "--json"; argidx++)
+        options.json_diagnostics = true;
+
+    // Arguments following the program belong to the script and are not interpreted here
+    if (argidx < argc)
+    {
+        const std::string firstarg = argv[argidx];
+        if (firstarg == "fmt")
+        {
+            // zylolang fmt [--check] [files...]
+            const bool check = argidx + 1 < argc && std::string(argv[argidx + 1]) == "--check";
+            const std::vector<std::string> paths(argv + argidx + (check ? 2 : 1), argv + argc);
+            return zylo_runner::format_files(paths, check, options);
+        }
+        if (firstarg == "template")
+        {
+            // zylolang template <file> [output]
+            if (argidx + 1 >= argc)
+            {
+                std::cerr << "Usage: zylolang [--json] template <file> [output]" << std::endl;
+                return 1;
+            }
+            return zylo_runner::run_template(argv[argidx + 1], argidx + 2 < argc ? argv[argidx + 2] : "", options);
+        }
+        if (firstarg == "-e")
+        {
+            if (argidx + 1 >= argc)
+            {
+                std::cerr << "Usage: zylolang [--json] -e <code> [args...]" << std::endl;
+                return 1;
+            }
+            return zylo_runner::run_source("<command line>", argv[argidx + 1], options);
+        }
+        if (firstarg == "-")
+            return zylo_runner::run_stdin(options);
+        return zylo_runner::run_file(firstarg, options);
+    }
+    if (argidx > 1 || !zylo_runner::is_interactive())
+        return zylo_runner::run_stdin(options);
+
     // Initialize terminal
     if (zylo_terminal::init() != 0)
     {
@@ -0,0 +1,234 @@
+/**
+ * @file runner.cxx
+ * @brief Implements the non-interactive entry points of the Zylo programming language.
+ *
+ * This file contains the implementation of functions declared in `runner.hxx`. It provides
+ * functionality for loading source code from files or the standard input and running it
+ * without initializing the terminal.
+ */
+
+#include "runner.hxx"
+#include "internal/lexer.hxx"
+#include "internal/formatter.hxx"
+#include "internal/module.hxx"
+#include "internal/macro.hxx"
+#include "internal/template.hxx"
+#include "diagnostics.hxx"
+#include "io.hxx"
+#include "parallel.hxx"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+bool zylo_runner::is_interactive()
+{
+    return isatty(fileno(stdin)) != 0;
+}
+
+/**
+ * @brief Prints the diagnostics of a run to the standard error stream.
+ *
+ * @param diagnostics The diagnostics of the run.
+ * @param options The options of the run, selecting the output format.
+ * @return Returns 0 if no error was reported, or 1 otherwise.
+ */
+static int flush_diagnostics(const zylo::Diagnostics &diagnostics, const zylo_runner::Options &options)
+{
+    if (options.json_diagnostics)
+        diagnostics.write_json(std::cerr);
+    else
+        diagnostics.print(std::cerr);
+    return diagnostics.error_count() == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Retrieves the source cache shared by all the runs of the process.
+ *
+ * @return A reference to the source cache.
+ */
+static zylo::SourceCache &source_cache()
+{
+    static zylo::SourceCache cache;
+    return cache;
+}
+
+/**
+ * @brief Runs the stages of the pipeline that follow module loading.
+ *
+ * @param modules The modules of the program, as returned by `zylo::load_modules`.
+ * @param diagnostics The diagnostics buffer of the run.
+ */
+static void run_modules(const zylo::Result<std::vector<zylo::Module>> &modules, zylo::Diagnostics &diagnostics)
+{
+    if (!modules)
+        return;
+    // One expander for the whole program, so that its expansion cache is shared by all modules
+    zylo::MacroExpander expander;
+    for (const auto &module : *modules)
+        expander.expand(*module.tokens, diagnostics, diagnostics.add_file(module.path));
+}
+
+int zylo_runner::run_source(const std::string &name, const std::string &source, const Options &options)
+{
+    zylo::Diagnostics diagnostics;
+    auto tokens = std::make_shared<const std::vector<Token>>(tokenize(source));
+    run_modules(zylo::load_modules(name, std::move(tokens), source_cache(), diagnostics), diagnostics);
+    return flush_diagnostics(diagnostics, options);
+}
+
+int zylo_runner::run_file(const std::string &path, const Options &options)
+{
+    zylo::Diagnostics diagnostics;
+    run_modules(zylo::load_modules(path, source_cache(), diagnostics), diagnostics);
+    return flush_diagnostics(diagnostics, options);
+}
+
+int zylo_runner::run_stdin(const Options &options)
+{
+    const std::string source((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    return run_source("<stdin>", source, options);
+}
+
+int zylo_runner::run_template(const std::string &path, const std::string &output, const Options &options)
+{
+    zylo::Diagnostics diagnostics;
+    const uint32_t file = diagnostics.add_file(path);
+    const zylo::MappedFile input(path);
+    if (!input.is_open())
+    {
+        diagnostics.report(zylo::DiagnosticCode::CouldNotOpenFile, file);
+        return flush_diagnostics(diagnostics, options);
+    }
+    // Opening the output would truncate the template while it is still mapped
+    std::error_code errcode;
+    if (!output.empty() && std::filesystem::equivalent(path, output, errcode))
+    {
+        diagnostics.report(zylo::DiagnosticCode::TemplateOverwrite, diagnostics.add_file(output));
+        return flush_diagnostics(diagnostics, options);
+    }
+    std::FILE *stream = output.empty() ? stdout : std::fopen(output.c_str(), "wb");
+    if (stream == nullptr)
+    {
+        diagnostics.report(zylo::DiagnosticCode::CouldNotOpenFile, diagnostics.add_file(output));
+        return flush_diagnostics(diagnostics, options);
+    }
+    {
+        zylo::BufferedWriter writer(stream);
+        zylo::render_template(input.view(), writer, diagnostics, file);
+        if (!writer.flush())
+            diagnostics.report(zylo::DiagnosticCode::CouldNotWriteFile, diagnostics.add_file(output.empty() ? "<stdout>" : output));
+    }
+    if (stream != stdout)
+        std::fclose(stream);
+    return flush_diagnostics(diagnostics, options);
+}
+
+int zylo_runner::format_files(const std::vector<std::string> &paths, bool check, const Options &options)
+{
+    if (paths.empty())
+    {
+        zylo::Diagnostics diagnostics;
+        const std::string source((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        const auto tokens = tokenize(source, diagnostics, diagnostics.add_file("<stdin>"));
+        int status = 0;
+        if (tokens)
+        {
+            std::ostringstream output;
+            zylo::format_tokens(*tokens, output, zylo::detect_line_ending(source));
+            if (!check)
+                std::cout << output.str();
+            else if (output.str() != source)
+                status = 1;
+        }
+        std::cout.flush();
+        return flush_diagnostics(diagnostics, options) | status;
+    }
+
+    std::vector<zylo::Diagnostics> diagnostics(paths.size()); // The diagnostics of each file
+    std::vector<char> unformatted(paths.size(), 0);           // Whether each file is not formatted (with `check`)
+    zylo::parallel_for(paths.size(), [&](size_t fileidx)
+    {
+        const std::string &path = paths[fileidx];
+        zylo::Diagnostics &filediagnostics = diagnostics[fileidx];
+        const uint32_t file = filediagnostics.add_file(path);
+        std::string formatted;
+        {
+            // The mapping must be gone before the file is replaced
+            const zylo::MappedFile input(path);
+            if (!input.is_open())
+            {
+                filediagnostics.report(zylo::DiagnosticCode::CouldNotOpenFile, file);
+                return;
+            }
+            const auto tokens = tokenize(input.view(), filediagnostics, file);
+            if (!tokens)
+                return;
+            std::ostringstream output;
+            zylo::format_tokens(*tokens, output, zylo::detect_line_ending(input.view()));
+            formatted = output.str();
+            if (formatted == input.view())
+                return;
+        }
+        if (check)
+        {
+            unformatted[fileidx] = 1;
+            return;
+        }
+        // Write a sibling file and move it over the source, so that a failed write leaves the source intact.
+        // The source is the file a symbolic link points to, and a file with other hard links is left alone,
+        // since moving a new file over it would split it from the other links.
+        std::error_code errcode;
+        const std::filesystem::path target = std::filesystem::canonical(path, errcode);
+        if (!errcode && std::filesystem::hard_link_count(target, errcode) > 1)
+        {
+            filediagnostics.report(zylo::DiagnosticCode::LinkedFile, file);
+            return;
+        }
+        if (errcode)
+        {
+            filediagnostics.report(zylo::DiagnosticCode::CouldNotWriteFile, file);
+            return;
+        }
+        const std::string temppath = target.string() + ".zylofmt";
+        {
+            std::ofstream output(temppath, std::ios::out | std::ios::binary | std::ios::trunc);
+            output.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+            output.close();
+            if (!output)
+                errcode = std::make_error_code(std::errc::io_error);
+        }
+        if (!errcode)
+            std::filesystem::permissions(temppath, std::filesystem::status(target).permissions(), errcode);
+        if (!errcode)
+            std::filesystem::rename(temppath, target, errcode);
+        if (errcode)
+        {
+            std::filesystem::remove(temppath, errcode);
+            filediagnostics.report(zylo::DiagnosticCode::CouldNotWriteFile, file);
+        }
+    });
+
+    zylo::Diagnostics alldiagnostics;
+    int status = 0;
+    for (size_t fileidx = 0; fileidx < paths.size(); fileidx++)
+    {
+        alldiagnostics.merge(diagnostics[fileidx]);
+        if (unformatted[fileidx])
+        {
+            std::cout << paths[fileidx] << '\n';
+            status = 1;
+        }
+    }
+    std::cout.flush();
+    return flush_diagnostics(alldiagnostics, options) | status;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file runner.hxx
+ * @brief Declares utilities for running Zylo programs non-interactively.
+ *
+ * This file declares the functions used when `zylolang` is launched with a script, an inline
+ * program (`-e`) or a program piped through the standard input. None of these paths touch the
+ * terminal (title, screen clearing, banner), which keeps startup cheap for batch jobs that launch
+ * the binary many times.
+ */
+
+#ifndef ZYLO_RUNNER_HXX
+#define ZYLO_RUNNER_HXX
+
+#include <string>
+#include <vector>
+
+/**
+ * @namespace zylo_runner
+ * @brief Contains the non-interactive entry points of the Zylo programming language.
+ *
+ * This namespace includes functions for loading Zylo source code from files, command line
+ * arguments or the standard input, and for feeding that source code through the language
+ * pipeline without any terminal interaction.
+ *
+ * @see zylo_terminal
+ */
+namespace zylo_runner
+{
+
+    /**
+     * @struct Options
+     * @brief Holds the command line options shared by all non-interactive runs.
+     */
+    struct Options
+    {
+        /**
+         * @brief Whether diagnostics are written as a JSON array instead of human-readable lines.
+         *
+         * Set by the `--json` command line option. The JSON array is written to the standard error
+         * stream, even when it is empty.
+         */
+        bool json_diagnostics = false;
+    };
+
+    /**
+     * @brief Determines whether the standard input is attached to an interactive terminal.
+     *
+     * This function is used to decide between starting the interactive prompt and reading a
+     * program from the standard input when `zylolang` is launched without arguments.
+     *
+     * @return `true` if the standard input is a terminal, `false` if it is redirected.
+     */
+    bool is_interactive();
+
+    /**
+     * @brief Runs a Zylo program held in memory.
+     *
+     * This function processes the given source code and the modules it imports through the
+     * language pipeline, collecting diagnostics in a buffer, and prints them to the standard error
+     * stream at the end of the run. Imported modules are resolved relative to the current directory.
+     *
+     * @param name The name used to refer to the program in error messages (e.g. the file path).
+     * @param source The source code of the program.
+     * @param options The options of the run.
+     * @return Returns 0 on success, or 1 if the program contains errors.
+     */
+    int run_source(const std::string &name, const std::string &source, const Options &options);
+
+    /**
+     * @brief Runs a Zylo program stored in a file.
+     *
+     * This function runs the file like `run_source`, resolving the modules it imports relative to
+     * the directory of the file.
+     *
+     * @param path The path of the script to run.
+     * @param options The options of the run.
+     * @return Returns 0 on success, or 1 if the file cannot be read or contains errors.
+     */
+    int run_file(const std::string &path, const Options &options);
+
+    /**
+     * @brief Runs a Zylo program read from the standard input.
+     *
+     * This function reads the standard input until the end of the stream and runs the result
+     * with `run_source`.
+     *
+     * @param options The options of the run.
+     * @return Returns 0 on success, or 1 if the program contains errors.
+     */
+    int run_stdin(const Options &options);
+
+    /**
+     * @brief Processes a template file.
+     *
+     * This function maps the template into memory and processes it with `zylo::render_template`,
+     * writing the result through a buffer as the template is scanned.
+     *
+     * @param path The path of the template file.
+     * @param output The path of the file receiving the result, or an empty string for the standard output.
+     *               It must not be the template itself.
+     * @param options The options of the run.
+     * @return Returns 0 on success, or 1 if a file cannot be opened, the output is the template or the template contains errors.
+     */
+    int run_template(const std::string &path, const std::string &output, const Options &options);
+
+    /**
+     * @brief Formats Zylo source files in place.
+     *
+     * This function rewrites every given file in the canonical layout produced by
+     * `zylo::format_tokens`. Files are formatted in parallel, one file per worker thread at a
+     * time, and diagnostics are reported in the order of the given paths. Files containing invalid
+     * tokens are reported and left untouched. A file is replaced by renaming a formatted copy
+     * over it, so a failed write never leaves it truncated. A symbolic link is followed and the file
+     * it points to is replaced; a file with other hard links is reported and left untouched. When no
+     * paths are given, the program read from the standard input is formatted to the standard output,
+     * or, with `check`, only compared with its formatted version.
+     *
+     * @param paths The paths of the files to format.
+     * @param check When `true`, files are not rewritten; the ones that are not formatted are listed instead.
+     * @param options The options of the run.
+     * @return Returns 0 on success, or 1 if a file cannot be formatted or, with `check`, is not formatted.
+     */
+    int format_files(const std::vector<std::string> &paths, bool check, const Options &options);
+
+} // namespace zylo_runner
+
+#endif // ZYLO_RUNNER_HXX
@@ -25,6 +25,14 @@
  */
 constexpr size_t DEFAULT_MEMORY_BUFFER_SIZE = 1024 * 1024; // 1 MB // TODO: Update value
 
+/**
+ * @brief The default size of the buffers used to write output.
+ *
+ * This constant specifies the default size (in bytes) of the buffer that `BufferedWriter` fills
+ * before handing the output to the operating system. Larger writes bypass the buffer.
+ */
+constexpr size_t DEFAULT_OUTPUT_BUFFER_SIZE = 64 * 1024; // 64 KB
+
 /**
  * @brief The version number of the Zylo programming language.
  *
@@ -41,4 +49,12 @@ constexpr const char *ZYLO_VERSION = "1.0.0";
  */
 constexpr const char *DEFAULT_LANGUAGE_NAME = "Zylo";
 
+/**
+ * @brief The maximum nesting depth of macro expansions.
+ *
+ * This constant bounds how many macro invocations may be expanded inside one another, so that a
+ * macro expanding to itself is reported instead of expanding forever.
+ */
+constexpr int MACRO_EXPANSION_DEPTH_LIMIT = 64;
+
 #endif // ZYLO_CONSTANTS_HXX
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * @file diagnostics.cxx
+ * @brief Implements the diagnostics engine of the Zylo programming language.
+ *
+ * This file contains the definitions of the members declared in `diagnostics.hxx`, along with
+ * the diagnostics table giving the severity, location and message format of every diagnostic
+ * code. Message formats reference arguments with `{0}`, `{1}`, etc.
+ */
+
+#include "diagnostics.hxx"
+#include "json.hxx"
+
+namespace
+{
+    /**
+     * @struct DiagnosticInfo
+     * @brief Describes a diagnostic code in the diagnostics table.
+     */
+    struct DiagnosticInfo
+    {
+        zylo::Error::Location location; // The stage reporting the diagnostic, `End` if none.
+        zylo::Severity severity;        // The severity of the diagnostic.
+        const char *format;             // The format of the message.
+    };
+
+    /**
+     * @brief The diagnostics table, indexed by `DiagnosticCode`.
+     */
+    const DiagnosticInfo diagnostic_infos[static_cast<int>(zylo::DiagnosticCode::End)] = {
+        {zylo::Error::Location::End, zylo::Severity::Note, ""},                                                         // None
+        {zylo::Error::Location::Lexer, zylo::Severity::Error, "Invalid token '{0}'"},                                   // InvalidToken
+        {zylo::Error::Location::End, zylo::Severity::Error, "Could not open file."},                                    // CouldNotOpenFile
+        {zylo::Error::Location::End, zylo::Severity::Error, "Could not write file."},                                   // CouldNotWriteFile
+        {zylo::Error::Location::Parser, zylo::Severity::Error, "Module '{0}' not found"},                               // ModuleNotFound
+        {zylo::Error::Location::Parser, zylo::Severity::Error, "Expected a module path after 'import'"},                // InvalidImport
+        {zylo::Error::Location::Parser, zylo::Severity::Error, "Cyclic import of '{0}'"},                               // CyclicImport
+        {zylo::Error::Location::Preprocessor, zylo::Severity::Error, "Malformed definition of macro '{0}'"},            // InvalidMacro
+        {zylo::Error::Location::Preprocessor, zylo::Severity::Error, "Macro '{0}' expects {1} argument(s)"},            // MacroArguments
+        {zylo::Error::Location::Preprocessor, zylo::Severity::Error, "Expansion of macro '{0}' is too deep"},           // MacroTooDeep
+        {zylo::Error::Location::Preprocessor, zylo::Severity::Error, "Unterminated template block, expected '?>'"},     // UnterminatedTemplate
+        {zylo::Error::Location::End, zylo::Severity::Error, "The output of a template cannot be the template itself."}, // TemplateOverwrite
+        {zylo::Error::Location::Lexer, zylo::Severity::Error, "Unterminated string literal, expected '\"'"},            // UnterminatedString
+        {zylo::Error::Location::End, zylo::Severity::Error, "A file with other hard links cannot be rewritten."},       // LinkedFile
+    };
+
+    /**
+     * @brief The names of the severities, indexed by `Severity`.
+     */
+    const char *const severity_names[] = {"Error", "Warning", "Note"};
+} // namespace
+
+uint32_t zylo::Diagnostics::add_file(const std::string &name)
+{
+    const auto inserted = fileidxs.emplace(name, static_cast<uint32_t>(files.size()));
+    if (inserted.second)
+        files.push_back(name);
+    return inserted.first->second;
+}
+
+size_t zylo::Diagnostics::report(DiagnosticCode code, uint32_t file, Span span, std::initializer_list<std::string_view> arguments)
+{
+    Diagnostic diagnostic;
+    diagnostic.code = code;
+    diagnostic.file = file;
+    diagnostic.span = span;
+    size_t argidx = 0;
+    for (auto argument = arguments.begin(); argument != arguments.end() && argidx < DIAGNOSTIC_ARGUMENT_SLOTS; ++argument, ++argidx)
+    {
+        diagnostic.arguments[argidx] = {static_cast<uint32_t>(text.size()), static_cast<uint32_t>(argument->size())};
+        text.append(argument->data(), argument->size());
+    }
+    diagnostics.push_back(diagnostic);
+    return diagnostics.size() - 1;
+}
+
+void zylo::Diagnostics::merge(const Diagnostics &other)
+{
+    const uint32_t textoffset = static_cast<uint32_t>(text.size());
+    text += other.text;
+    // Map the files of the other buffer once, rather than once per diagnostic
+    std::vector<uint32_t> filemap;
+    filemap.reserve(other.files.size());
+    for (const auto &name : other.files)
+        filemap.push_back(add_file(name));
+    diagnostics.reserve(diagnostics.size() + other.diagnostics.size());
+    for (Diagnostic diagnostic : other.diagnostics)
+    {
+        diagnostic.file = filemap[diagnostic.file];
+        for (auto &argument : diagnostic.arguments)
+            argument.offset += textoffset;
+        diagnostics.push_back(diagnostic);
+    }
+}
+
+void zylo::Diagnostics::clear()
+{
+    diagnostics.clear();
+    files.clear();
+    fileidxs.clear();
+    text.clear();
+}
+
+size_t zylo::Diagnostics::size() const
+{
+    return diagnostics.size();
+}
+
+size_t zylo::Diagnostics::error_count() const
+{
+    size_t errcount = 0;
+    for (const auto &diagnostic : diagnostics)
+    {
+        if (severity(diagnostic.code) == Severity::Error)
+            errcount++;
+    }
+    return errcount;
+}
+
+const zylo::Diagnostic &zylo::Diagnostics::operator[](size_t index) const
+{
+    return diagnostics[index];
+}
+
+std::string zylo::Diagnostics::message(size_t index) const
+{
+    const Diagnostic &diagnostic = diagnostics[index];
+    const char *format = diagnostic_infos[static_cast<int>(diagnostic.code)].format;
+    std::string message;
+    for (const char *chr = format; *chr != '\0'; chr++)
+    {
+        // Substitute `{N}` with the N-th argument
+        if (chr[0] == '{' && chr[1] >= '0' && chr[1] < '0' + static_cast<int>(DIAGNOSTIC_ARGUMENT_SLOTS) && chr[2] == '}')
+        {
+            const Diagnostic::Argument &argument = diagnostic.arguments[chr[1] - '0'];
+            message.append(text, argument.offset, argument.size);
+            chr += 2;
+            continue;
+        }
+        message += *chr;
+    }
+    return message;
+}
+
+zylo::Error zylo::Diagnostics::to_error(size_t index) const
+{
+    const DiagnosticCode code = diagnostics[index].code;
+    return Error(diagnostic_infos[static_cast<int>(code)].location, static_cast<int>(code), message(index));
+}
+
+void zylo::Diagnostics::print(std::ostream &ostream) const
+{
+    for (size_t index = 0; index < diagnostics.size(); index++)
+    {
+        const Diagnostic &diagnostic = diagnostics[index];
+        const DiagnosticInfo &info = diagnostic_infos[static_cast<int>(diagnostic.code)];
+        ostream << files[diagnostic.file] << ":";
+        if (diagnostic.span.line > 0)
+            ostream << diagnostic.span.line << ":" << diagnostic.span.column << ":";
+        ostream << " ";
+        if (info.location != Error::Location::End)
+            ostream << "[" << Error::locations[static_cast<int>(info.location)] << "] ";
+        ostream << severity_names[static_cast<int>(info.severity)] << " "
+                << static_cast<int>(diagnostic.code) << ": " << message(index) << '\n';
+    }
+    ostream.flush();
+}
+
+void zylo::Diagnostics::write_json(std::ostream &ostream) const
+{
+    std::string json;
+    JsonWriter writer(json);
+    writer.begin_array();
+    for (size_t index = 0; index < diagnostics.size(); index++)
+    {
+        const Diagnostic &diagnostic = diagnostics[index];
+        const DiagnosticInfo &info = diagnostic_infos[static_cast<int>(diagnostic.code)];
+        writer.begin_object();
+        writer.key("file");
+        writer.value(files[diagnostic.file]);
+        writer.key("line");
+        writer.value(diagnostic.span.line);
+        writer.key("column");
+        writer.value(diagnostic.span.column);
+        writer.key("length");
+        writer.value(diagnostic.span.length);
+        writer.key("severity");
+        writer.value(severity_names[static_cast<int>(info.severity)]);
+        writer.key("location");
+        if (info.location == Error::Location::End)
+            writer.null();
+        else
+            writer.value(Error::locations[static_cast<int>(info.location)]);
+        writer.key("code");
+        writer.value(static_cast<uint32_t>(diagnostic.code));
+        writer.key("message");
+        writer.value(message(index));
+        writer.end_object();
+    }
+    writer.end_array();
+    json += '\n';
+    ostream.write(json.data(), static_cast<std::streamsize>(json.size()));
+    ostream.flush();
+}
+
+zylo::Severity zylo::Diagnostics::severity(DiagnosticCode code)
+{
+    return diagnostic_infos[static_cast<int>(code)].severity;
+}
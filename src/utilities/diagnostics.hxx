@@ -0,0 +1,235 @@
+/**
+ * @file diagnostics.hxx
+ * @brief Defines the diagnostics engine of the Zylo programming language.
+ *
+ * This file contains the declaration of the `Diagnostics` class and its related types, which are
+ * used to collect the errors and warnings reported while processing Zylo source code. Diagnostics
+ * are stored as compact records made of a code, a source span and argument slots; their message
+ * text is only formatted when they are printed, so reporting a large number of diagnostics costs
+ * little more than appending records to a buffer. Collected diagnostics can be printed in a
+ * human-readable form or as JSON for tools.
+ */
+
+#ifndef ZYLO_DIAGNOSTICS_HXX // ZYLO_DIAGNOSTICS_HXX
+#define ZYLO_DIAGNOSTICS_HXX
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "error.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @enum DiagnosticCode
+     * @brief Enumerates the diagnostics that can be reported.
+     *
+     * Each code has an entry in the diagnostics table, which gives its severity, the stage of the
+     * processing pipeline reporting it and its message format. The numeric value of a code is the
+     * error code shown to users, so existing values must never change.
+     */
+    enum class DiagnosticCode : uint16_t
+    {
+        None,                 // No diagnostic
+        InvalidToken,         // A sequence of characters that is not a valid token: {0} token text
+        CouldNotOpenFile,     // A file that cannot be opened
+        CouldNotWriteFile,    // A file that cannot be written
+        ModuleNotFound,       // An imported module that cannot be opened: {0} module path
+        InvalidImport,        // An `import` keyword not followed by a module path
+        CyclicImport,         // A module importing itself through its imports: {0} module path
+        InvalidMacro,         // A malformed macro definition: {0} macro name
+        MacroArguments,       // A macro invoked with the wrong number of arguments: {0} macro name, {1} expected count
+        MacroTooDeep,         // Macro expansions nested beyond the depth limit: {0} macro name
+        UnterminatedTemplate, // A template block without its closing delimiter
+        TemplateOverwrite,    // A template whose output file is the template itself
+        UnterminatedString,   // A string literal without its closing quote on the same line
+        LinkedFile,           // A file to rewrite in place that has other hard links
+        End                   // Marker for the end of the enumeration
+    };
+
+    /**
+     * @enum Severity
+     * @brief Enumerates the severities of diagnostics.
+     */
+    enum class Severity : uint8_t
+    {
+        Error,   // The input cannot be processed
+        Warning, // The input can be processed but is likely wrong
+        Note     // Additional information about another diagnostic
+    };
+
+    /**
+     * @struct Span
+     * @brief Represents a range of source code.
+     *
+     * A span with a line of 0 does not point at source code (e.g. a file that cannot be opened).
+     */
+    struct Span
+    {
+        uint32_t line = 0;   // The 1-based line where the span starts.
+        uint32_t column = 0; // The 1-based column where the span starts.
+        uint32_t length = 0; // The length of the span, in bytes.
+    };
+
+    /**
+     * @brief The number of argument slots of a diagnostic.
+     */
+    constexpr size_t DIAGNOSTIC_ARGUMENT_SLOTS = 2;
+
+    /**
+     * @struct Diagnostic
+     * @brief Represents a reported diagnostic.
+     *
+     * This structure is a fixed-size record. Arguments are not stored in the record itself but
+     * in the text buffer of the `Diagnostics` object that owns it, and file names are stored
+     * once per buffer.
+     */
+    struct Diagnostic
+    {
+        /**
+         * @struct Argument
+         * @brief Locates the text of an argument in the text buffer of the owning `Diagnostics`.
+         */
+        struct Argument
+        {
+            uint32_t offset = 0; // The offset of the argument in the text buffer.
+            uint32_t size = 0;   // The size of the argument, in bytes.
+        };
+
+        DiagnosticCode code = DiagnosticCode::None;     // The code of the diagnostic.
+        uint32_t file = 0;                              // The index of the file name in the owning buffer.
+        Span span;                                      // The source code the diagnostic points at.
+        Argument arguments[DIAGNOSTIC_ARGUMENT_SLOTS]; // The arguments of the message format.
+    };
+
+    /**
+     * @class Diagnostics
+     * @brief A buffer collecting the diagnostics of a compilation.
+     *
+     * The `Diagnostics` class stores diagnostics in the order they are reported. A buffer is meant
+     * to be owned by a single compilation (or a single thread); buffers filled in parallel can be
+     * combined afterwards with `merge`.
+     */
+    class Diagnostics
+    {
+    public:
+        /**
+         * @brief Registers a file name and returns its index.
+         *
+         * Registering the same name twice returns the same index. Names are looked up in a hash
+         * table, so the cost does not grow with the number of files.
+         *
+         * @param name The name of the file, as shown in messages.
+         * @return The index identifying the file in reported diagnostics.
+         */
+        uint32_t add_file(const std::string &name);
+
+        /**
+         * @brief Reports a diagnostic.
+         *
+         * This method only appends a record and copies the argument text; no message is formatted.
+         *
+         * @param code The code of the diagnostic.
+         * @param file The index of the file, as returned by `add_file`.
+         * @param span The source code the diagnostic points at.
+         * @param arguments The arguments of the message format, at most `DIAGNOSTIC_ARGUMENT_SLOTS`.
+         * @return The index of the reported diagnostic.
+         */
+        size_t report(DiagnosticCode code, uint32_t file, Span span = Span(), std::initializer_list<std::string_view> arguments = {});
+
+        /**
+         * @brief Appends all the diagnostics of another buffer to this one.
+         *
+         * The files of the other buffer are registered once, and the file index of every appended
+         * diagnostic is translated through the resulting table.
+         *
+         * @param other The buffer whose diagnostics are appended.
+         */
+        void merge(const Diagnostics &other);
+
+        /**
+         * @brief Removes all diagnostics and file names.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the number of reported diagnostics.
+         *
+         * @return The number of diagnostics in the buffer.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Retrieves the number of reported diagnostics with the `Severity::Error` severity.
+         *
+         * @return The number of errors in the buffer.
+         */
+        size_t error_count() const;
+
+        /**
+         * @brief Retrieves a reported diagnostic.
+         *
+         * @param index The index of the diagnostic, as returned by `report`.
+         * @return A reference to the diagnostic record.
+         */
+        const Diagnostic &operator[](size_t index) const;
+
+        /**
+         * @brief Formats the message of a reported diagnostic.
+         *
+         * @param index The index of the diagnostic.
+         * @return The message of the diagnostic, with its arguments substituted.
+         */
+        std::string message(size_t index) const;
+
+        /**
+         * @brief Converts a reported diagnostic into an `Error` object.
+         *
+         * @param index The index of the diagnostic.
+         * @return An `Error` with the location, code and message of the diagnostic.
+         */
+        Error to_error(size_t index) const;
+
+        /**
+         * @brief Prints all diagnostics in a human-readable form, one per line.
+         *
+         * Each line has the form `file:line:column: [Location] Error code: message`.
+         *
+         * @param ostream The output stream where the diagnostics are written.
+         */
+        void print(std::ostream &ostream) const;
+
+        /**
+         * @brief Writes all diagnostics as a JSON array.
+         *
+         * Each diagnostic is written as an object with the `file`, `line`, `column`, `length`,
+         * `severity`, `location`, `code` and `message` members. The array is serialized into a
+         * single buffer and written with one call, followed by a line ending.
+         *
+         * @param ostream The output stream where the JSON document is written.
+         */
+        void write_json(std::ostream &ostream) const;
+
+        /**
+         * @brief Retrieves the severity of a diagnostic code.
+         *
+         * @param code The code of the diagnostic.
+         * @return The severity given to the code by the diagnostics table.
+         */
+        static Severity severity(DiagnosticCode code);
+
+    private:
+        std::vector<Diagnostic> diagnostics;                // The reported diagnostics.
+        std::vector<std::string> files;                     // The names of the files referenced by diagnostics.
+        std::unordered_map<std::string, uint32_t> fileidxs; // The index of every file name in `files`.
+        std::string text;                                   // The text of all diagnostic arguments.
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_DIAGNOSTICS_HXX
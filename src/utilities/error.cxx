@@ -0,0 +1,30 @@
+/**
+ * @file error.cxx
+ * @brief Implements the Error class used for error handling within the Zylo programming language.
+ *
+ * This file contains the definitions of the members declared in `error.hxx`, including the
+ * constructors, the table of location names, and the stream insertion operator used to print
+ * errors in a human-readable form.
+ */
+
+#include "error.hxx"
+#include <utility>
+
+const std::string zylo::Error::locations[static_cast<int>(zylo::Error::Location::End)] = {
+    "Lexer",        // Lexer
+    "Preprocessor", // Preprocessor
+    "Parser",       // Parser
+    "Interpreter"   // Interpreter
+};
+
+zylo::Error::Error() : location(Location::End), code(0), message() {}
+
+zylo::Error::Error(Location location, int code, std::string message)
+    : location(location), code(code), message(std::move(message)) {}
+
+std::ostream &zylo::operator<<(std::ostream &ostream, const Error &error)
+{
+    if (error.location != Error::Location::End)
+        ostream << "[" << Error::locations[static_cast<int>(error.location)] << "] ";
+    return ostream << "Error " << error.code << ": " << error.message;
+}
@@ -39,6 +39,8 @@ namespace zylo
          *
          * - `Lexer`: Errors occurring during lexical analysis
          *
+         * - `Preprocessor`: Errors occurring during macro expansion or template rendering
+         *
          * - `Parser`: Errors occurring during syntax parsing
          *
          * - `Interpreter`: Errors occurring during interpretation or execution of Zylo code
@@ -48,6 +50,7 @@ namespace zylo
         enum class Location
         {
             Lexer,
+            Preprocessor,
             Parser,
             Interpreter,
             End
@@ -86,6 +89,11 @@ namespace zylo
          */
         friend std::ostream &operator<<(std::ostream &ostream, const Error &error);
 
+        /**
+         * @brief The diagnostics engine prints location names the same way errors do.
+         */
+        friend class Diagnostics;
+
     private:
         /**
          * @brief An array of strings representing the names of the error locations.
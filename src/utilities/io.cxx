@@ -0,0 +1,166 @@
+/**
+ * @file io.cxx
+ * @brief Implements file input and output utilities for the Zylo programming language.
+ *
+ * This file contains the definitions of the members declared in `io.hxx`. Files are mapped with
+ * `CreateFileMapping`/`MapViewOfFile` on Windows and with `mmap` on other systems.
+ */
+
+#include <cstring>
+#include "io.hxx"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+zylo::MappedFile::MappedFile(const std::string &path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    LARGE_INTEGER filesize;
+    if (!GetFileSizeEx(file, &filesize))
+        filesize.QuadPart = -1;
+    if (filesize.QuadPart == 0)
+        opened = true;
+    else if (filesize.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            contents = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+        length = contents != nullptr ? static_cast<size_t>(filesize.QuadPart) : 0;
+        opened = contents != nullptr;
+    }
+    CloseHandle(file);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+    struct stat filestat;
+    if (fstat(file, &filestat) == 0 && S_ISREG(filestat.st_mode))
+    {
+        if (filestat.st_size == 0)
+            opened = true;
+        else
+        {
+            void *mapping = mmap(nullptr, static_cast<size_t>(filestat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
+            {
+                madvise(mapping, static_cast<size_t>(filestat.st_size), MADV_SEQUENTIAL);
+                contents = static_cast<const char *>(mapping);
+                length = static_cast<size_t>(filestat.st_size);
+                opened = true;
+            }
+        }
+    }
+    close(file); // The mapping keeps the file alive
+#endif
+}
+
+zylo::MappedFile::~MappedFile()
+{
+    if (contents == nullptr)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(contents);
+#else
+    munmap(const_cast<char *>(contents), length);
+#endif
+}
+
+bool zylo::MappedFile::is_open() const
+{
+    return opened;
+}
+
+const char *zylo::MappedFile::data() const
+{
+    return contents;
+}
+
+size_t zylo::MappedFile::size() const
+{
+    return length;
+}
+
+std::string_view zylo::MappedFile::view() const
+{
+    return contents != nullptr ? std::string_view(contents, length) : std::string_view();
+}
+
+zylo::LineReader::LineReader(std::string_view text) : text(text) {}
+
+bool zylo::LineReader::next(std::string_view &line)
+{
+    if (pos >= text.size())
+        return false;
+    const void *newline = std::memchr(text.data() + pos, '\n', text.size() - pos);
+    const size_t end = newline != nullptr ? static_cast<size_t>(static_cast<const char *>(newline) - text.data()) + 1 : text.size();
+    line = text.substr(pos, end - pos);
+    pos = end;
+    count++;
+    return true;
+}
+
+size_t zylo::LineReader::line_number() const
+{
+    return count;
+}
+
+zylo::BufferedWriter::BufferedWriter(std::FILE *stream, size_t capacity)
+    : stream(stream), buffer(capacity) {}
+
+zylo::BufferedWriter::~BufferedWriter()
+{
+    flush();
+}
+
+void zylo::BufferedWriter::write(const char *data, size_t size)
+{
+    if (size > buffer.size() - used)
+    {
+        drain();
+        if (size >= buffer.size())
+        {
+            // Too large to be worth copying, hand it to the stream as is
+            error |= std::fwrite(data, 1, size, stream) != size;
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+void zylo::BufferedWriter::write(std::string_view string)
+{
+    write(string.data(), string.size());
+}
+
+bool zylo::BufferedWriter::flush()
+{
+    drain();
+    error |= std::fflush(stream) != 0;
+    return !error;
+}
+
+bool zylo::BufferedWriter::failed() const
+{
+    return error;
+}
+
+void zylo::BufferedWriter::drain()
+{
+    if (used == 0)
+        return;
+    error |= std::fwrite(buffer.data(), 1, used, stream) != used;
+    used = 0;
+}
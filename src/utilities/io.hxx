@@ -0,0 +1,196 @@
+/**
+ * @file io.hxx
+ * @brief Defines file input and output utilities for the Zylo programming language.
+ *
+ * This file contains the declaration of the `MappedFile` class, which gives read-only access to
+ * the contents of a file by mapping it into memory instead of copying it, and of the
+ * `LineReader` class, which splits a text into lines without copying it, and of the
+ * `BufferedWriter` class, which gathers small writes into a fixed-size buffer before handing them
+ * to the operating system. Together they let large inputs be processed in a streaming fashion,
+ * with memory use independent of the size of the input.
+ */
+
+#ifndef ZYLO_IO_HXX // ZYLO_IO_HXX
+#define ZYLO_IO_HXX
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "constants.hxx"
+
+namespace zylo
+{
+
+    /**
+     * @class MappedFile
+     * @brief Maps the contents of a file into memory for reading.
+     *
+     * The contents of the file stay valid for the lifetime of the `MappedFile` object. Pages are
+     * loaded by the operating system on first access, so opening a file is cheap regardless of
+     * its size. Empty files are opened successfully with a size of 0.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Maps a file into memory.
+         *
+         * @param path The path of the file to map. Use `is_open` to check whether it succeeded.
+         */
+        explicit MappedFile(const std::string &path);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief Determines whether the file was mapped.
+         *
+         * @return `true` if the file was mapped, `false` if it cannot be opened or mapped.
+         */
+        bool is_open() const;
+
+        /**
+         * @brief Retrieves the contents of the file.
+         *
+         * @return A pointer to the first byte of the file, or `nullptr` for empty or unmapped files.
+         */
+        const char *data() const;
+
+        /**
+         * @brief Retrieves the size of the file.
+         *
+         * @return The size of the file, in bytes.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Retrieves the contents of the file as a string view.
+         *
+         * @return A view over the whole file, without copying it.
+         */
+        std::string_view view() const;
+
+    private:
+        const char *contents = nullptr; // The mapped contents of the file.
+        size_t length = 0;              // The size of the file, in bytes.
+        bool opened = false;            // Whether the file was mapped.
+    };
+
+    /**
+     * @class LineReader
+     * @brief Splits a text into lines without copying it.
+     *
+     * Lines are returned as views into the text, so no memory is allocated per line. Line endings
+     * are found with `memchr`, which the C library implements with vector instructions. Each line
+     * includes its terminating `\n`, if any, so the lines of a text put back together give the
+     * text again.
+     */
+    class LineReader
+    {
+    public:
+        /**
+         * @brief Constructs a reader over a text.
+         *
+         * @param text The text to split. It must outlive the reader and the lines it returns.
+         */
+        explicit LineReader(std::string_view text);
+
+        /**
+         * @brief Reads the next line.
+         *
+         * @param line The view receiving the line, including its terminating `\n` if any.
+         * @return `true` if a line was read, `false` at the end of the text.
+         */
+        bool next(std::string_view &line);
+
+        /**
+         * @brief Retrieves the number of lines read so far.
+         *
+         * @return The number of lines read, which is also the 1-based number of the last line read.
+         */
+        size_t line_number() const;
+
+    private:
+        std::string_view text; // The text being split.
+        size_t pos = 0;        // The index where the next line starts.
+        size_t count = 0;      // The number of lines read so far.
+    };
+
+    /**
+     * @class BufferedWriter
+     * @brief Writes output to a C stream through a fixed-size buffer.
+     *
+     * Writes are copied into the buffer, which is handed to the stream when full, when `flush` is
+     * called and when the writer is destroyed. Writes larger than the buffer go straight to the
+     * stream once the buffer has been flushed, so they are never copied.
+     */
+    class BufferedWriter
+    {
+    public:
+        /**
+         * @brief Constructs a writer over a C stream.
+         *
+         * @param stream The stream receiving the output (e.g. `stdout` or a file opened with `fopen`).
+         * The writer does not close it.
+         * @param capacity The size of the buffer, in bytes.
+         */
+        explicit BufferedWriter(std::FILE *stream, size_t capacity = DEFAULT_OUTPUT_BUFFER_SIZE);
+
+        /**
+         * @brief Flushes the remaining output.
+         */
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter &) = delete;
+        BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+        /**
+         * @brief Writes a sequence of bytes.
+         *
+         * @param data The bytes to write.
+         * @param size The number of bytes to write.
+         */
+        void write(const char *data, size_t size);
+
+        /**
+         * @brief Writes a string.
+         *
+         * @param string The string to write.
+         */
+        void write(std::string_view string);
+
+        /**
+         * @brief Hands the buffered output to the stream and flushes the stream.
+         *
+         * @return `true` if all the output written so far reached the stream.
+         */
+        bool flush();
+
+        /**
+         * @brief Determines whether writing to the stream failed.
+         *
+         * @return `true` if any output could not be written.
+         */
+        bool failed() const;
+
+    private:
+        /**
+         * @brief Hands the buffered output to the stream without flushing the stream.
+         */
+        void drain();
+
+        std::FILE *stream;        // The stream receiving the output.
+        std::vector<char> buffer; // The buffered output.
+        size_t used = 0;          // The number of bytes used in the buffer.
+        bool error = false;       // Whether writing to the stream failed.
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_IO_HXX
@@ -0,0 +1,131 @@
+/**
+ * @file json.cxx
+ * @brief Implements the JSON serializer of the Zylo programming language.
+ *
+ * This file contains the definitions of the members declared in `json.hxx`. Strings are escaped
+ * by copying the runs of characters that need no escaping in bulk.
+ */
+
+#include "json.hxx"
+
+zylo::JsonWriter::JsonWriter(std::string &buffer) : buffer(buffer) {}
+
+void zylo::JsonWriter::begin_object()
+{
+    separate();
+    buffer += '{';
+    firsts.push_back(true);
+}
+
+void zylo::JsonWriter::end_object()
+{
+    buffer += '}';
+    firsts.pop_back();
+}
+
+void zylo::JsonWriter::begin_array()
+{
+    separate();
+    buffer += '[';
+    firsts.push_back(true);
+}
+
+void zylo::JsonWriter::end_array()
+{
+    buffer += ']';
+    firsts.pop_back();
+}
+
+void zylo::JsonWriter::key(std::string_view name)
+{
+    value(name);
+    buffer += ':';
+    afterkey = true;
+}
+
+void zylo::JsonWriter::value(std::string_view string)
+{
+    static const char hexdigits[] = "0123456789abcdef";
+    separate();
+    buffer += '\"';
+    size_t runstart = 0; // The start of the run of characters that need no escaping
+    for (size_t chridx = 0; chridx < string.size(); chridx++)
+    {
+        const unsigned char chr = static_cast<unsigned char>(string[chridx]);
+        if (chr >= 0x20 && chr != '\"' && chr != '\\')
+            continue;
+        buffer.append(string.data() + runstart, chridx - runstart);
+        runstart = chridx + 1;
+        switch (chr)
+        {
+        case '\"':
+            buffer += "\\\"";
+            break;
+        case '\\':
+            buffer += "\\\\";
+            break;
+        case '\n':
+            buffer += "\\n";
+            break;
+        case '\t':
+            buffer += "\\t";
+            break;
+        default:
+            buffer += "\\u00";
+            buffer += hexdigits[chr >> 4];
+            buffer += hexdigits[chr & 0xF];
+            break;
+        }
+    }
+    buffer.append(string.data() + runstart, string.size() - runstart);
+    buffer += '\"';
+}
+
+void zylo::JsonWriter::value(const char *string)
+{
+    value(std::string_view(string));
+}
+
+void zylo::JsonWriter::value(int64_t number)
+{
+    separate();
+    buffer += std::to_string(number);
+}
+
+void zylo::JsonWriter::value(uint64_t number)
+{
+    separate();
+    buffer += std::to_string(number);
+}
+
+void zylo::JsonWriter::value(uint32_t number)
+{
+    value(static_cast<uint64_t>(number));
+}
+
+void zylo::JsonWriter::value(bool boolean)
+{
+    separate();
+    buffer += boolean ? "true" : "false";
+}
+
+void zylo::JsonWriter::null()
+{
+    separate();
+    buffer += "null";
+}
+
+void zylo::JsonWriter::separate()
+{
+    if (afterkey)
+    {
+        afterkey = false;
+        return;
+    }
+    if (!firsts.empty())
+    {
+        if (!firsts.back())
+            buffer += ',';
+        firsts.back() = false;
+    }
+}
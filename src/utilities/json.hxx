@@ -0,0 +1,127 @@
+/**
+ * @file json.hxx
+ * @brief Defines the JSON serializer of the Zylo programming language.
+ *
+ * This file contains the declaration of the `JsonWriter` class, which serializes values as JSON
+ * into a single growing string. Nothing is written to a stream while serializing: the caller
+ * hands the finished buffer to its output in one write, which avoids the per-call overhead of
+ * formatted stream output.
+ */
+
+#ifndef ZYLO_JSON_HXX // ZYLO_JSON_HXX
+#define ZYLO_JSON_HXX
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zylo
+{
+
+    /**
+     * @class JsonWriter
+     * @brief Serializes JSON values into a string.
+     *
+     * The writer emits compact JSON (no whitespace). Commas between array elements and object
+     * members are inserted automatically. Inside an object, every value must be preceded by a
+     * call to `key`.
+     */
+    class JsonWriter
+    {
+    public:
+        /**
+         * @brief Constructs a writer appending to a string.
+         *
+         * @param buffer The string receiving the JSON text. It must outlive the writer.
+         */
+        explicit JsonWriter(std::string &buffer);
+
+        /**
+         * @brief Opens an object, to be closed with `end_object`.
+         */
+        void begin_object();
+
+        /**
+         * @brief Closes the innermost open object.
+         */
+        void end_object();
+
+        /**
+         * @brief Opens an array, to be closed with `end_array`.
+         */
+        void begin_array();
+
+        /**
+         * @brief Closes the innermost open array.
+         */
+        void end_array();
+
+        /**
+         * @brief Writes the key of the next object member.
+         *
+         * @param name The name of the member.
+         */
+        void key(std::string_view name);
+
+        /**
+         * @brief Writes a string value, escaping it as needed.
+         *
+         * @param string The string to write.
+         */
+        void value(std::string_view string);
+
+        /**
+         * @brief Writes a string value, escaping it as needed.
+         *
+         * @param string The null-terminated string to write.
+         */
+        void value(const char *string);
+
+        /**
+         * @brief Writes a number value.
+         *
+         * @param number The number to write.
+         */
+        void value(int64_t number);
+
+        /**
+         * @brief Writes a number value.
+         *
+         * @param number The number to write.
+         */
+        void value(uint64_t number);
+
+        /**
+         * @brief Writes a number value.
+         *
+         * @param number The number to write.
+         */
+        void value(uint32_t number);
+
+        /**
+         * @brief Writes a boolean value.
+         *
+         * @param boolean The boolean to write.
+         */
+        void value(bool boolean);
+
+        /**
+         * @brief Writes a `null` value.
+         */
+        void null();
+
+    private:
+        /**
+         * @brief Writes the comma separating the next value from the previous one, if needed.
+         */
+        void separate();
+
+        std::string &buffer;     // The string receiving the JSON text.
+        std::vector<bool> firsts; // For each open array or object, whether it is still empty.
+        bool afterkey = false;    // Whether the next value follows a key.
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_JSON_HXX
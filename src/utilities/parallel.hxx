@@ -0,0 +1,53 @@
+/**
+ * @file parallel.hxx
+ * @brief Defines utilities for running independent work items in parallel.
+ *
+ * This file contains the `parallel_for` function template, which spreads a set of independent
+ * work items (such as files to format or modules to load) over a bounded number of threads.
+ */
+
+#ifndef ZYLO_PARALLEL_HXX // ZYLO_PARALLEL_HXX
+#define ZYLO_PARALLEL_HXX
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace zylo
+{
+
+    /**
+     * @brief Calls a function for every index of a range, using as many threads as the hardware runs.
+     *
+     * Work items are handed out one at a time, so items of uneven cost are balanced between
+     * threads. The calling thread takes part in the work, and the function returns once every
+     * item has been processed. No thread is started for a single item.
+     *
+     * @tparam Function The type of the function, callable as `function(size_t index)`.
+     * @param count The number of work items; indices go from 0 to `count - 1`.
+     * @param function The function processing a work item. It is called concurrently, so it may
+     * only write state owned by its item.
+     */
+    template <typename Function>
+    void parallel_for(size_t count, Function function)
+    {
+        std::atomic<size_t> nextidx{0}; // The index of the next work item
+        auto worker = [&]()
+        {
+            for (size_t idx = nextidx++; idx < count; idx = nextidx++)
+                function(idx);
+        };
+        const size_t threadcount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), count);
+        std::vector<std::thread> threads;
+        for (size_t threadidx = 1; threadidx < threadcount; threadidx++)
+            threads.emplace_back(worker);
+        worker();
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+} // namespace zylo
+
+#endif // ZYLO_PARALLEL_HXX
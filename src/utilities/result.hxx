@@ -0,0 +1,115 @@
+/**
+ * @file result.hxx
+ * @brief Defines the Result class used to propagate errors within the Zylo programming language.
+ *
+ * This file contains the declaration of the `Result` class template and the `ErrorRef` structure.
+ * The stages of the processing pipeline (lexer, parser, compiler) return a `Result` holding either
+ * the value they produced or a reference to the first error they reported in the diagnostics
+ * buffer of the compilation. Errors travel as plain return values: no exception is thrown, so the
+ * success path carries no exception-handling cost and a file producing many errors never unwinds
+ * the stack.
+ */
+
+#ifndef ZYLO_RESULT_HXX // ZYLO_RESULT_HXX
+#define ZYLO_RESULT_HXX
+
+#include <cstddef>
+#include <utility>
+#include <variant>
+
+namespace zylo
+{
+
+    /**
+     * @struct ErrorRef
+     * @brief Refers to an error stored in a diagnostics buffer.
+     *
+     * An `ErrorRef` is only meaningful together with the `Diagnostics` object the error was
+     * reported to; use `Diagnostics::operator[]`, `Diagnostics::message` or
+     * `Diagnostics::to_error` to inspect it.
+     */
+    struct ErrorRef
+    {
+        size_t index; // The index of the error in its diagnostics buffer.
+    };
+
+    /**
+     * @class Result
+     * @brief Holds either a value or a reference to an error.
+     *
+     * The `Result` class is returned by operations that can fail. Callers check `ok()` (or convert
+     * the result to `bool`) before accessing the value; accessing the value of a failed result, or
+     * the error of a successful one, is undefined behavior.
+     *
+     * @tparam Type The type of the value held on success.
+     */
+    template <typename Type>
+    class Result
+    {
+    public:
+        /**
+         * @brief Constructs a successful result holding a value.
+         *
+         * @param value The value produced by the operation.
+         */
+        Result(Type value) : content(std::in_place_index<0>, std::move(value)) {}
+
+        /**
+         * @brief Constructs a failed result referring to an error.
+         *
+         * @param error The reference to the error reported by the operation.
+         */
+        Result(ErrorRef error) : content(std::in_place_index<1>, error) {}
+
+        /**
+         * @brief Determines whether the operation succeeded.
+         *
+         * @return `true` if the result holds a value, `false` if it refers to an error.
+         */
+        bool ok() const { return content.index() == 0; }
+
+        /**
+         * @brief Determines whether the operation succeeded.
+         *
+         * @return `true` if the result holds a value, `false` if it refers to an error.
+         */
+        explicit operator bool() const { return ok(); }
+
+        /**
+         * @brief Retrieves the value of a successful result.
+         *
+         * @return A reference to the value.
+         */
+        Type &value() { return *std::get_if<0>(&content); }
+
+        /**
+         * @brief Retrieves the value of a successful result.
+         *
+         * @return A constant reference to the value.
+         */
+        const Type &value() const { return *std::get_if<0>(&content); }
+
+        /**
+         * @brief Retrieves the error of a failed result.
+         *
+         * @return The reference to the error.
+         */
+        ErrorRef error() const { return *std::get_if<1>(&content); }
+
+        Type &operator*() { return value(); }
+        const Type &operator*() const { return value(); }
+        Type *operator->() { return &value(); }
+        const Type *operator->() const { return &value(); }
+
+    private:
+        /**
+         * @brief The value or the error held by the result.
+         *
+         * `std::get_if` is used to access it, which never throws.
+         */
+        std::variant<Type, ErrorRef> content;
+    };
+
+} // namespace zylo
+
+#endif // ZYLO_RESULT_HXX
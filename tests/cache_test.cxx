@@ -0,0 +1,97 @@
+/**
+ * @file cache_test.cxx
+ * @brief Checks the source cache of the Zylo programming language.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "check.hxx"
+#include "internal/cache.hxx"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Joins the values of a token stream with spaces.
+     *
+     * @param tokens The token stream, as returned by `SourceCache::load`.
+     * @return The values of the tokens, or `<null>` if there is no token stream.
+     */
+    std::string describe(const zylo::SourceCache::Tokens &tokens)
+    {
+        if (tokens == nullptr)
+            return "<null>";
+        std::string described;
+        for (const auto &token : *tokens)
+        {
+            if (token.type != TokenType::EndOfLine && token.type != TokenType::EndOfFile)
+                described += (described.empty() ? "" : " ") + token.value;
+        }
+        return described;
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+
+    const zylo_tests::TempDirectory directory;
+    zylo::SourceCache cache;
+    const std::string path = directory.write("main.zy", "zylo x = 1\n");
+
+    const auto first = cache.load(path);
+    check(describe(first), std::string("zylo x = 1"), "a file is tokenized on its first load");
+    check(cache.load(path) == first, true, "an unchanged file keeps its cached tokens");
+    check(cache.size(), size_t(1), "a loaded file has an entry");
+
+    // Touching a file changes its time but not its contents
+    const auto mtime = std::filesystem::last_write_time(path);
+    std::filesystem::last_write_time(path, mtime + std::chrono::hours(1));
+    check(cache.load(path) == first, true, "a touched file keeps its cached tokens");
+
+    // An edit within the resolution of the file system clock keeps the time but not the size
+    const auto touchedmtime = std::filesystem::last_write_time(path);
+    directory.write("main.zy", "zylo x = 12\n");
+    std::filesystem::last_write_time(path, touchedmtime);
+    check(describe(cache.load(path)), std::string("zylo x = 12"), "a file whose size changed is tokenized again");
+
+    directory.write("main.zy", "zylo y = 34\n");
+    std::filesystem::last_write_time(path, touchedmtime + std::chrono::hours(1));
+    check(describe(cache.load(path)), std::string("zylo y = 34"), "a file whose contents changed is tokenized again");
+
+    // Neither the time nor the size change, which the cache cannot see until told
+    const auto editedmtime = std::filesystem::last_write_time(path);
+    directory.write("main.zy", "zylo z = 56\n");
+    std::filesystem::last_write_time(path, editedmtime);
+    check(describe(cache.load(path)), std::string("zylo y = 34"), "an edit keeping the time and the size is not seen");
+    cache.invalidate(path);
+    check(cache.size(), size_t(0), "an invalidated file has no entry");
+    check(describe(cache.load(path)), std::string("zylo z = 56"), "an invalidated file is tokenized again");
+
+    check(describe(cache.load((directory.path / "missing.zy").string())), std::string("<null>"), "a missing file cannot be loaded");
+    cache.clear();
+    check(cache.size(), size_t(0), "clearing the cache removes every entry");
+
+#ifndef _WIN32
+    // A pipe, as passed by `zylolang <(gen)`, cannot be mapped and is read as a stream
+    const std::string pipepath = (directory.path / "pipe.zy").string();
+    if (mkfifo(pipepath.c_str(), 0600) == 0)
+    {
+        std::thread writer([&pipepath]()
+        {
+            std::ofstream(pipepath, std::ios::out | std::ios::binary) << "zylo p = 1\n";
+        });
+        check(describe(cache.load(pipepath)), std::string("zylo p = 1"), "a pipe is read as a stream");
+        writer.join();
+        check(cache.size(), size_t(0), "a pipe is not cached");
+    }
+#endif
+
+    return zylo_tests::check_result();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file check.hxx
+ * @brief Defines the helpers shared by the tests of the Zylo programming language.
+ *
+ * A test is a standalone program: every failed `check` is printed, and `check_result` turns the
+ * number of failures into the exit code of the program.
+ */
+
+#ifndef ZYLO_TESTS_CHECK_HXX // ZYLO_TESTS_CHECK_HXX
+#define ZYLO_TESTS_CHECK_HXX
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace zylo_tests
+{
+    /**
+     * @brief The number of failed checks of the running test.
+     */
+    inline int failures = 0;
+
+    /**
+     * @brief Checks that two values are equal, printing both of them if they are not.
+     *
+     * @param actual The value produced by the code under test.
+     * @param expected The expected value.
+     * @param description What is being checked.
+     */
+    template <typename Type>
+    void check(const Type &actual, const Type &expected, const std::string &description)
+    {
+        if (actual == expected)
+            return;
+        failures++;
+        std::cerr << "FAILED: " << description << "\n  expected: " << expected << "\n  actual:   " << actual << "\n";
+    }
+
+    /**
+     * @brief Retrieves the exit code of the running test.
+     *
+     * @return 0 if every check passed, 1 otherwise.
+     */
+    inline int check_result()
+    {
+        return failures == 0 ? 0 : 1;
+    }
+
+    /**
+     * @class TempDirectory
+     * @brief A directory of test files, removed with everything in it when destroyed.
+     */
+    class TempDirectory
+    {
+    public:
+        TempDirectory()
+            : path(std::filesystem::temp_directory_path() / ("zylo_test_" + std::to_string(std::random_device()())))
+        {
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDirectory()
+        {
+            std::error_code errcode;
+            std::filesystem::remove_all(path, errcode);
+        }
+
+        TempDirectory(const TempDirectory &) = delete;
+        TempDirectory &operator=(const TempDirectory &) = delete;
+
+        /**
+         * @brief Writes a file in the directory, replacing it if it exists.
+         *
+         * @param name The name of the file, relative to the directory.
+         * @param contents The contents of the file.
+         * @return The path of the file.
+         */
+        std::string write(const std::string &name, const std::string &contents) const
+        {
+            const std::filesystem::path filepath = path / name;
+            std::ofstream(filepath, std::ios::out | std::ios::binary | std::ios::trunc) << contents;
+            return filepath.string();
+        }
+
+        /**
+         * @brief Reads a file of the directory.
+         *
+         * @param name The name of the file, relative to the directory.
+         * @return The contents of the file, or an empty string if it cannot be read.
+         */
+        std::string read(const std::string &name) const
+        {
+            std::ifstream file(path / name, std::ios::in | std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        }
+
+        /**
+         * @brief The path of the directory.
+         */
+        const std::filesystem::path path;
+    };
+} // namespace zylo_tests
+
+#endif // ZYLO_TESTS_CHECK_HXX
@@ -0,0 +1,120 @@
+/**
+ * @file formatter_test.cxx
+ * @brief Checks the source formatter of the Zylo programming language.
+ */
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "check.hxx"
+#include "internal/formatter.hxx"
+
+namespace
+{
+    /**
+     * @brief Formats a source with the line ending it uses.
+     *
+     * @param source The source to format.
+     * @return The formatted source.
+     */
+    std::string format(const std::string &source)
+    {
+        std::ostringstream formatted;
+        zylo::format_tokens(tokenize(source), formatted, zylo::detect_line_ending(source));
+        return formatted.str();
+    }
+
+    /**
+     * @brief Describes the tokens of a source, ignoring their positions and blank lines.
+     *
+     * @param source The source to tokenize.
+     * @return The types and values of the tokens, or an empty string if a token is invalid.
+     */
+    std::string describe_tokens(const std::string &source)
+    {
+        std::string described;
+        bool pendingline = false; // Whether a line ending is waiting for the next token
+        for (const auto &token : tokenize(source))
+        {
+            if (token.type == TokenType::Invalid)
+                return "";
+            if (token.type == TokenType::EndOfFile)
+                break;
+            if (token.type == TokenType::EndOfLine && token.value == "\n")
+            {
+                pendingline = !described.empty();
+                continue;
+            }
+            if (pendingline)
+                described += "\\n ";
+            pendingline = false;
+            described += std::to_string(static_cast<int>(token.type)) + ":" + token.value + " ";
+        }
+        return described;
+    }
+
+    /**
+     * @brief Generates a random source from a vocabulary of tokens, with random spacing.
+     *
+     * @param random The random number generator.
+     * @return The generated source.
+     */
+    std::string generate_source(std::mt19937 &random)
+    {
+        static const std::vector<std::string> vocabulary = {
+            "zylo", "const", "func", "over", "if", "else", "while", "import", "macro", "true", "false",
+            "x", "y", "done", "f", "1", "2.5", "-1", ".5", "\"s\"", "\"a b\"", "\"q\\\"\"", "\"\"", "\"\\\\\"",
+            "=", "++", "--", "!", "+", "-", "*", "/", "%", "==", "!=", ">", "<", ">=", "<=", "**", "&&", "||",
+            "(", ")", "[", "]", ",", ";", "\n", "# c"};
+        static const std::vector<std::string> spacing = {" ", " ", "  ", "\t", ""};
+        std::string source;
+        const size_t count = random() % 12 + 1;
+        for (size_t tkidx = 0; tkidx < count; tkidx++)
+        {
+            const std::string &token = vocabulary[random() % vocabulary.size()];
+            source += token;
+            source += token == "# c" ? "\n" : spacing[random() % spacing.size()];
+        }
+        return source;
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+
+    check(format("zylo  x=f( 1 ,2 )\n"), std::string("zylo x = f(1, 2)\n"), "tokens are spaced canonically");
+    // Without a grammar, a block after a condition is only told apart from a call by the source spacing
+    check(format("if x >= y ( return x )\n"), std::string("if x >= y (return x)\n"), "blocks after an if condition stay apart");
+    check(format("while !done ( step() )\n"), std::string("while !done (step())\n"), "blocks after a while condition stay apart");
+    check(format("a[0](1)(2)\n"), std::string("a[0](1)(2)\n"), "chained calls stay attached");
+    check(format("zylo x = 1\r\n\r\nzylo y = 2\r\n"), std::string("zylo x = 1\r\n\r\nzylo y = 2\r\n"), "CRLF line endings are kept");
+    check(format("zylo x = 1\n"), std::string("zylo x = 1\n"), "LF line endings are kept");
+
+    check(format("zylo z = ! !done\n"), std::string("zylo z = ! !done\n"), "a prefix operator stays apart from an operator");
+    check(format("zylo z = ! ++x\n"), std::string("zylo z = ! ++x\n"), "a prefix operator stays apart from a prefix operator");
+    check(format("zylo z = !  \"s\"\n"), std::string("zylo z = ! \"s\"\n"), "a prefix operator stays apart from a string");
+    check(format("zylo z = ! -1\n"), std::string("zylo z = !-1\n"), "a prefix operator sticks to a signed number");
+    check(format("zylo z = !  done\n"), std::string("zylo z = !done\n"), "a prefix operator sticks to an identifier");
+
+    check(format("zylo s = \"a\\rb\"\n"), std::string("zylo s = \"a\\rb\"\n"), "an unknown escape keeps its spelling");
+    check(format("zylo s = \"\\x41\"\n"), std::string("zylo s = \"\\x41\"\n"), "a hexadecimal escape keeps its spelling");
+    check(format("zylo s = \"\\\\n \\\\\\\" \\n a\\\\\"\n"), std::string("zylo s = \"\\\\n \\\\\\\" \\n a\\\\\"\n"), "escaped backslashes keep their spelling");
+
+    // Formatting must never change the tokens of a valid source, only their layout
+    std::mt19937 random(20261018);
+    for (int srcidx = 0; srcidx < 50000; srcidx++)
+    {
+        const std::string source = generate_source(random);
+        const std::string tokens = describe_tokens(source);
+        if (tokens.empty())
+            continue;
+        const std::string formatted = format(source);
+        check(describe_tokens(formatted), tokens, "formatting keeps the tokens of '" + source + "' (formatted as '" + formatted + "')");
+        if (zylo_tests::failures >= 10)
+            break;
+    }
+
+    return zylo_tests::check_result();
+}
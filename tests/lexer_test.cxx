@@ -0,0 +1,86 @@
+/**
+ * @file lexer_test.cxx
+ * @brief Checks the lexer of the Zylo programming language.
+ */
+
+#include <random>
+#include <string>
+#include "check.hxx"
+#include "internal/lexer.hxx"
+
+namespace
+{
+    /**
+     * @brief Tokenizes a source, describing every token as `type:value`.
+     *
+     * @param source The source to tokenize.
+     * @return The descriptions of the tokens, separated by spaces, line endings shown as `\n`.
+     */
+    std::string describe(const std::string &source)
+    {
+        std::string described;
+        for (const auto &token : tokenize(source))
+        {
+            const std::string value = token.type == TokenType::EndOfLine && token.value == "\n" ? "\\n" : token.value;
+            described += (described.empty() ? "" : " ") + std::to_string(static_cast<int>(token.type)) + ":" + value;
+        }
+        return described;
+    }
+
+    /**
+     * @brief Tokenizes a source, returning the message of its first diagnostic.
+     *
+     * @param source The source to tokenize.
+     * @return The message of the first diagnostic, or an empty string if there is none.
+     */
+    std::string first_diagnostic(const std::string &source)
+    {
+        zylo::Diagnostics diagnostics;
+        const auto tokens = tokenize(source, diagnostics, diagnostics.add_file("test.zy"));
+        return tokens ? std::string() : diagnostics.message(tokens.error().index);
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+    auto type = [](TokenType tktype) -> std::string
+    {
+        return std::to_string(static_cast<int>(tktype)) + ":";
+    };
+    const std::string eol = type(TokenType::EndOfLine) + "\\n";
+    const std::string eof = type(TokenType::EndOfFile);
+
+    check(describe("\"x # y\"\n"), type(TokenType::String) + "x # y " + eol + " " + eof, "'#' inside a string is part of the string");
+    check(describe("\"q\\\"r\" # c\n"), type(TokenType::String) + "q\"r " + type(TokenType::Comment) + "# c " + eol + " " + eof,
+          "an escaped quote does not end a string");
+    // An unterminated string stops at its line, so the next line is not merged into it
+    check(describe("\"abc\nx\n"), type(TokenType::Invalid) + "\"abc " + eol + " " + type(TokenType::Identifier) + "x " + eol + " " + eof,
+          "an unterminated string ends with its line");
+    check(describe("\"a\\\"\n"), type(TokenType::Invalid) + "\"a\\\" " + eol + " " + eof, "a string ending with an escaped quote is unterminated");
+    check(first_diagnostic("zylo x = \"abc\nzylo y = 1\n"), std::string("Unterminated string literal, expected '\"'"),
+          "unterminated strings are reported");
+    check(first_diagnostic("zylo x = \"\"\n"), std::string(), "empty strings are terminated");
+
+    // Escaping a string value and processing it again gives the value back
+    std::mt19937 random(20261018);
+    const std::string alphabet = "ant\\\"\n\tx";
+    for (int validx = 0; validx < 10000; validx++)
+    {
+        std::string value;
+        for (size_t length = random() % 8; length > 0; length--)
+            value += alphabet[random() % alphabet.size()];
+        std::string escaped = value;
+        unprocess_escape_characters(escaped);
+        std::string processed = escaped;
+        process_escape_characters(processed);
+        check(processed, value, "escaping '" + escaped + "' is undone by processing it");
+        const auto tokens = tokenize("\"" + escaped + "\"");
+        const bool isstring = tokens.size() == 2 && tokens[0].type == TokenType::String;
+        check(isstring ? tokens[0].value : "<not a single string>", value, "'\"" + escaped + "\"' lexes as the escaped value");
+        if (zylo_tests::failures >= 10)
+            break;
+    }
+
+    return zylo_tests::check_result();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file macro_test.cxx
+ * @brief Checks the macro expander of the Zylo programming language.
+ */
+
+#include <string>
+#include <vector>
+#include "check.hxx"
+#include "internal/macro.hxx"
+
+namespace
+{
+    /**
+     * @brief Expands a source, joining the values of the resulting tokens with spaces.
+     *
+     * @param source The source to expand.
+     * @return The expanded tokens, or the first diagnostic if the expansion failed.
+     */
+    std::string expand(const std::string &source)
+    {
+        zylo::Diagnostics diagnostics;
+        zylo::MacroExpander expander;
+        const auto expanded = expander.expand(tokenize(source), diagnostics, diagnostics.add_file("test.zy"));
+        if (!expanded)
+            return diagnostics.message(expanded.error().index);
+        std::string joined;
+        for (const auto &token : *expanded)
+        {
+            if (token.type == TokenType::EndOfLine || token.type == TokenType::EndOfFile)
+                continue;
+            joined += joined.empty() ? token.value : " " + token.value;
+        }
+        return joined;
+    }
+
+    /**
+     * @brief Expands several sources with one expander, as the modules of a program are.
+     *
+     * @param sources The sources to expand, in order.
+     * @return The expanded tokens of every source, joined with spaces, sources separated by `|`.
+     */
+    std::string expand_modules(const std::vector<std::string> &sources)
+    {
+        zylo::Diagnostics diagnostics;
+        zylo::MacroExpander expander;
+        std::string joined;
+        for (const auto &source : sources)
+        {
+            const auto expanded = expander.expand(tokenize(source), diagnostics, diagnostics.add_file("test.zy"));
+            if (!expanded)
+                return diagnostics.message(expanded.error().index);
+            joined += joined.empty() ? "" : " |";
+            for (const auto &token : *expanded)
+            {
+                if (token.type != TokenType::EndOfLine && token.type != TokenType::EndOfFile)
+                    joined += joined.empty() ? token.value : " " + token.value;
+            }
+        }
+        return joined;
+    }
+
+    /**
+     * @brief Expands a source, counting the diagnostics reported.
+     *
+     * @param source The source to expand.
+     * @return The number of diagnostics.
+     */
+    size_t count_diagnostics(const std::string &source)
+    {
+        zylo::Diagnostics diagnostics;
+        zylo::MacroExpander expander;
+        expander.expand(tokenize(source), diagnostics, diagnostics.add_file("test.zy"));
+        return diagnostics.size();
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+
+    check(expand("macro N(a) ( a + 1 )\nN(2)\n"), std::string("2 + 1"), "parameters are substituted");
+    check(expand("macro M() ( zylo t = 1 )\nM()\nM()\n"), std::string("zylo t$0 = 1 zylo t$1 = 1"),
+          "every expansion renames its locals");
+    // A cached expansion must keep the locals of the enclosing expansion it was given as arguments
+    check(expand("macro N(a) ( a + 1 )\nmacro M() ( zylo t = 1 N(t) N(t) )\nM()\n"), std::string("zylo t$0 = 1 t$0 + 1 t$0 + 1"),
+          "cached nested expansions keep the names passed as arguments");
+    check(expand("macro N(a) ( zylo u = a )\nmacro M() ( zylo t = 1 N(t) N(t) )\nM()\nM()\n"),
+          std::string("zylo t$0 = 1 zylo u$1 = t$0 zylo u$2 = t$0 zylo t$3 = 1 zylo u$4 = t$3 zylo u$5 = t$3"),
+          "cached expansions renumber only their own locals");
+    // Cached expansions depend on the macros invoked in their body and in their arguments
+    check(expand("macro inner() ( 1 )\nmacro outer() ( inner() )\nouter()\nmacro inner() ( 2 )\nouter()\n"), std::string("1 2"),
+          "redefining a macro invoked by a cached expansion");
+    check(expand("macro id(a) ( a )\nid(f(1))\nmacro f(x) ( 9 )\nid(f(1))\n"), std::string("f ( 1 ) 9"),
+          "defining a macro invoked in the arguments of a cached expansion");
+    check(expand_modules({"macro inner() ( 1 )\nmacro outer() ( inner() )\nouter()\n", "macro inner() ( 2 )\nmacro outer() ( inner() )\nouter()\n"}),
+          std::string("1 | 2"), "modules sharing an expander see their own definitions");
+    // The invocation after the stray bracket must still be seen, not swallowed as an argument
+    check(count_diagnostics("macro N(a) ( a )\nN(1 ] 2)\nN(1, 2)\n"), size_t(2), "a stray closing bracket ends the arguments");
+
+    return zylo_tests::check_result();
+}
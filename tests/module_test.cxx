@@ -0,0 +1,80 @@
+/**
+ * @file module_test.cxx
+ * @brief Checks the module loader of the Zylo programming language.
+ */
+
+#include <filesystem>
+#include <string>
+#include "check.hxx"
+#include "internal/module.hxx"
+
+namespace
+{
+    /**
+     * @brief Loads a program, describing its modules by file name in the order they are returned.
+     *
+     * @param path The path of the main file of the program.
+     * @return The file names of the modules, each followed by the positions of its imports, or the
+     * first diagnostic if the program could not be loaded.
+     */
+    std::string load(const std::string &path)
+    {
+        zylo::SourceCache cache;
+        zylo::Diagnostics diagnostics;
+        const auto modules = zylo::load_modules(path, cache, diagnostics);
+        if (!modules)
+            return diagnostics.message(modules.error().index);
+        std::string described;
+        for (const auto &module : *modules)
+        {
+            described += (described.empty() ? "" : " ") + std::filesystem::path(module.path).filename().string();
+            for (const size_t import : module.imports)
+                described += ":" + std::to_string(import);
+        }
+        return described;
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+
+    {
+        // `shared.zy` is imported by both sides of the diamond, once through another relative path
+        const zylo_tests::TempDirectory directory;
+        std::filesystem::create_directories(directory.path / "lib");
+        directory.write("shared.zy", "zylo s = 1\n");
+        directory.write("left.zy", "import \"shared.zy\"\n");
+        directory.write("lib/right.zy", "import \"../shared.zy\"\n");
+        const std::string path = directory.write("main.zy", "import \"left.zy\"\nimport \"lib/right.zy\"\n");
+        check(load(path), std::string("shared.zy left.zy:0 right.zy:0 main.zy:1:2"), "a diamond loads its shared module once, before its importers");
+    }
+    {
+        const zylo_tests::TempDirectory directory;
+        directory.write("c.zy", "zylo c = 1\n");
+        directory.write("b.zy", "import \"c.zy\"\n");
+        directory.write("a.zy", "import \"b.zy\"\n");
+        const std::string path = directory.write("main.zy", "import \"a.zy\"\nimport \"c.zy\"\n");
+        check(load(path), std::string("c.zy b.zy:0 a.zy:1 main.zy:2:0"), "modules come after their imports and the main module is last");
+    }
+    {
+        const zylo_tests::TempDirectory directory;
+        directory.write("a.zy", "import \"b.zy\"\n");
+        directory.write("b.zy", "import \"a.zy\"\n");
+        const std::string path = directory.write("main.zy", "import \"a.zy\"\n");
+        check(load(path), std::string("Cyclic import of '") + (directory.path / "a.zy").string() + "'", "an import cycle is reported");
+    }
+    {
+        const zylo_tests::TempDirectory directory;
+        const std::string path = directory.write("main.zy", "import \"missing.zy\"\n");
+        check(load(path), std::string("Module '") + (directory.path / "missing.zy").string() + "' not found", "a missing module is reported");
+    }
+    {
+        const zylo_tests::TempDirectory directory;
+        const std::string path = directory.write("main.zy", "import missing\n");
+        check(load(path), std::string("Expected a module path after 'import'"), "an import without a path is reported");
+        check(load((directory.path / "none.zy").string()), std::string("Could not open file."), "a missing main file is reported");
+    }
+
+    return zylo_tests::check_result();
+}
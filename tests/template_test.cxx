@@ -0,0 +1,87 @@
+/**
+ * @file template_test.cxx
+ * @brief Checks the template engine of the Zylo programming language.
+ */
+
+#include <cstdio>
+#include <string>
+#include "check.hxx"
+#include "internal/template.hxx"
+#include "runner.hxx"
+
+namespace
+{
+    /**
+     * @brief Renders a template, returning its output.
+     *
+     * @param input The contents of the template.
+     * @param diagnostics The buffer receiving the diagnostics of the template.
+     * @return The output of the template.
+     */
+    std::string render(const std::string &input, zylo::Diagnostics &diagnostics)
+    {
+        std::FILE *stream = std::tmpfile();
+        {
+            zylo::BufferedWriter writer(stream);
+            zylo::render_template(input, writer, diagnostics, diagnostics.add_file("test.zyt"));
+        }
+        std::rewind(stream);
+        std::string output;
+        for (int chr; (chr = std::fgetc(stream)) != EOF;)
+            output += static_cast<char>(chr);
+        std::fclose(stream);
+        return output;
+    }
+
+    /**
+     * @brief Describes the first diagnostic of a buffer as `line:column message`.
+     *
+     * @param diagnostics The diagnostics buffer.
+     * @return The description of the first diagnostic, or an empty string if there is none.
+     */
+    std::string first_diagnostic(const zylo::Diagnostics &diagnostics)
+    {
+        if (diagnostics.size() == 0)
+            return "";
+        const zylo::Span &span = diagnostics[0].span;
+        return std::to_string(span.line) + ":" + std::to_string(span.column) + " " + diagnostics.message(0);
+    }
+} // namespace
+
+int main()
+{
+    using zylo_tests::check;
+
+    {
+        zylo::Diagnostics diagnostics;
+        check(render("<html>\n  <p>?></p>\n</html>\n", diagnostics), std::string("<html>\n  <p>?></p>\n</html>\n"), "text without blocks is copied as it is");
+        check(render("a<?zylo zylo x = 1 ?>b\n<?zylo\nover\n?>c", diagnostics), std::string("ab\nc"), "blocks are removed from the literal text");
+        check(diagnostics.size(), size_t(0), "a valid template has no diagnostics");
+    }
+    {
+        zylo::Diagnostics diagnostics;
+        render("line\nab<?zylo zylo @ ?>\n", diagnostics);
+        check(first_diagnostic(diagnostics), std::string("2:15 Invalid token '@'"), "a block on the line of its opening delimiter is shifted by its column");
+    }
+    {
+        zylo::Diagnostics diagnostics;
+        render("line\nab<?zylo\n  zylo\n   @ ?>\n", diagnostics);
+        check(first_diagnostic(diagnostics), std::string("4:4 Invalid token '@'"), "the later lines of a block keep their columns");
+    }
+    {
+        zylo::Diagnostics diagnostics;
+        check(render("abc\n  <?zylo x", diagnostics), std::string("abc\n  "), "the text before an unterminated block is copied");
+        check(first_diagnostic(diagnostics), std::string("2:3 Unterminated template block, expected '?>'"), "an unterminated block is reported at its delimiter");
+    }
+    {
+        const zylo_tests::TempDirectory directory;
+        const std::string path = directory.write("page.zyt", "a<?zylo zylo x = 1 ?>b\n");
+        const std::string output = (directory.path / "page.txt").string();
+        check(zylo_runner::run_template(path, output, {}), 0, "a template is rendered to another file");
+        check(directory.read("page.txt"), std::string("ab\n"), "the output file holds the rendered template");
+        check(zylo_runner::run_template(path, path, {}), 1, "a template cannot be rendered over itself");
+        check(directory.read("page.zyt"), std::string("a<?zylo zylo x = 1 ?>b\n"), "a template rendered over itself is left intact");
+    }
+
+    return zylo_tests::check_result();
+}